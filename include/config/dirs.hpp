@@ -32,6 +32,7 @@ struct Directories {
     pn::string registry;
     pn::string replays;
     pn::string scenarios;
+    pn::string cache;  // Empty if nothing should be cached.
 };
 
 const Directories& dirs();
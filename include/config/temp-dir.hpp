@@ -0,0 +1,42 @@
+// Copyright (C) 1997, 1999-2001, 2008 Nathan Lamont
+// Copyright (C) 2013-2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#ifndef ANTARES_CONFIG_TEMP_DIR_HPP_
+#define ANTARES_CONFIG_TEMP_DIR_HPP_
+
+#include <pn/string>
+
+namespace antares {
+
+// A new directory under /tmp, removed along with its contents when destroyed.  For tests.
+class TempDir {
+  public:
+    explicit TempDir(pn::string_view prefix);
+    TempDir(const TempDir&) = delete;
+    TempDir& operator=(const TempDir&) = delete;
+    ~TempDir();
+
+    pn::string_view path() const { return _path; }
+
+  private:
+    pn::string _path;
+};
+
+}  // namespace antares
+
+#endif  // ANTARES_CONFIG_TEMP_DIR_HPP_
@@ -28,6 +28,8 @@
 
 namespace antares {
 
+// The default size of the space object pool.  Replays were recorded against this limit; with a
+// larger pool, objects that would have been dropped get created, so the replay diverges.
 const int32_t kMaxSpaceObject = 250;
 
 const ticks kTimeToCheckHome = secs(15);
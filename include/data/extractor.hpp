@@ -48,6 +48,7 @@ class DataExtractor {
     void download(
             Observer* observer, pn::string_view base, pn::string_view name,
             pn::string_view version, const sfz::sha1::digest& digest) const;
+    void pack(Observer* observer, pn::string_view scenario_identifier) const;
     void write_version(pn::string_view scenario_identifier) const;
     void extract_original(Observer* observer, pn::string_view zip) const;
     void extract_supplemental(Observer* observer, pn::string_view zip) const;
@@ -0,0 +1,187 @@
+// Copyright (C) 1997, 1999-2001, 2008 Nathan Lamont
+// Copyright (C) 2008-2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#ifndef ANTARES_DATA_POOL_HPP_
+#define ANTARES_DATA_POOL_HPP_
+
+#include <stdint.h>
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+namespace antares {
+
+template <typename T>
+class Pool;
+
+// The number of the pool slot that holds an object, for types kept in a Pool, which must have a
+// `PoolSlot pool_slot` member.  The pool numbers each slot when it makes it, and assigning one
+// object over another doesn't move it to a different slot, so the number survives the objects
+// being copied in and out of slots.
+class PoolSlot {
+  public:
+    PoolSlot() = default;
+    PoolSlot(const PoolSlot&) = default;
+    PoolSlot& operator=(const PoolSlot&) { return *this; }
+
+    int number() const { return _number; }
+
+  private:
+    template <typename T>
+    friend class Pool;
+
+    int _number = -1;
+};
+
+// A growable array of slots, addressed by number, that always hands out the lowest-numbered free
+// slot.  That matches the linear scans it replaces, so objects land in the same slots as before
+// and replays stay in sync.
+//
+// Slots live in fixed-size pages, and growing the pool adds a page without moving the existing
+// ones, so pointers into the pool stay valid until the next `reset()`.  The pool starts with one
+// page and grows on demand, up to `capacity()` slots.
+//
+// Free slots are tracked in a bitmap with one bit per slot, plus a summary bitmap with one bit
+// per 64-slot word.  Finding the lowest free slot scans one summary word per 4096 slots.
+template <typename T>
+class Pool {
+  public:
+    enum { SLOTS_PER_PAGE = 256 };
+
+    Pool() = default;
+    Pool(const Pool&) = delete;
+    Pool& operator=(const Pool&) = delete;
+
+    // Discards every slot and starts over with room for `capacity` slots.
+    void reset(int capacity) {
+        _capacity = capacity;
+        _size     = 0;
+        _pages.clear();
+        _free.assign((capacity + 63) / 64, 0);
+        _summary.assign((_free.size() + 63) / 64, 0);
+        grow();
+    }
+
+    // The most slots the pool will ever hold.
+    int capacity() const { return _capacity; }
+
+    // The number of slots that exist right now.  Slots at or past `size()` have never been
+    // handed out, so loops over every slot can stop there.
+    int size() const { return _size; }
+
+    T* get(int number) const {
+        if ((0 <= number) && (number < _size)) {
+            return &_pages[number / SLOTS_PER_PAGE][number % SLOTS_PER_PAGE];
+        }
+        return nullptr;
+    }
+
+    // Returns the number of the slot at `t`, which must point into the pool.
+    int number(const T* t) const { return t->pool_slot.number(); }
+
+    // Marks the lowest-numbered free slot as used, and returns its number, adding a page if
+    // there are no free slots left.  Returns -1 if the pool is at capacity.
+    int allocate() {
+        for (int i = 0; i < _summary.size(); ++i) {
+            if (_summary[i]) {
+                int word = (i * 64) + __builtin_ctzll(_summary[i]);
+                int bit  = __builtin_ctzll(_free[word]);
+                int slot = (word * 64) + bit;
+                take(slot);
+                return slot;
+            }
+        }
+        if (_size < _capacity) {
+            int slot = _size;
+            grow();
+            take(slot);
+            return slot;
+        }
+        return -1;
+    }
+
+    // Marks slot `number` as free again.  Freeing a free slot does nothing.
+    void release(int number) {
+        if ((0 <= number) && (number < _size)) {
+            const int word = number / 64;
+            _free[word] |= uint64_t(1) << (number % 64);
+            _summary[word / 64] |= uint64_t(1) << (word % 64);
+        }
+    }
+
+    // Marks every slot as free, without touching their contents.
+    void release_all() {
+        for (int i = 0; i < _size; ++i) {
+            release(i);
+        }
+    }
+
+    // Makes this pool a copy of `other`, slot for slot.  Pages that both pools have are copied
+    // in place, so pointers into them stay valid.
+    void assign(const Pool& other) {
+        _capacity = other._capacity;
+        _size     = other._size;
+        _free     = other._free;
+        _summary  = other._summary;
+        _pages.resize(other._pages.size());
+        for (int i = 0; i < _pages.size(); ++i) {
+            if (!_pages[i]) {
+                _pages[i] = new_page(i);
+            }
+            std::copy(
+                    other._pages[i].get(), other._pages[i].get() + SLOTS_PER_PAGE,
+                    _pages[i].get());
+        }
+    }
+
+  private:
+    void grow() {
+        const int begin = _size;
+        _pages.push_back(new_page(_pages.size()));
+        _size = std::min<int>(_capacity, _pages.size() * SLOTS_PER_PAGE);
+        for (int i = begin; i < _size; ++i) {
+            release(i);
+        }
+    }
+
+    static std::unique_ptr<T[]> new_page(int index) {
+        std::unique_ptr<T[]> page(new T[SLOTS_PER_PAGE]);
+        for (int i = 0; i < SLOTS_PER_PAGE; ++i) {
+            page[i].pool_slot._number = (index * SLOTS_PER_PAGE) + i;
+        }
+        return page;
+    }
+
+    void take(int number) {
+        const int word = number / 64;
+        _free[word] &= ~(uint64_t(1) << (number % 64));
+        if (!_free[word]) {
+            _summary[word / 64] &= ~(uint64_t(1) << (word % 64));
+        }
+    }
+
+    int                               _capacity = 0;
+    int                               _size     = 0;
+    std::vector<std::unique_ptr<T[]>> _pages;
+    std::vector<uint64_t>             _free;
+    std::vector<uint64_t>             _summary;
+};
+
+}  // namespace antares
+
+#endif  // ANTARES_DATA_POOL_HPP_
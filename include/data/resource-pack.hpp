@@ -0,0 +1,80 @@
+// Copyright (C) 1997, 1999-2001, 2008 Nathan Lamont
+// Copyright (C) 2008-2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#ifndef ANTARES_DATA_RESOURCE_PACK_HPP_
+#define ANTARES_DATA_RESOURCE_PACK_HPP_
+
+#include <stdint.h>
+#include <memory>
+#include <pn/data>
+#include <pn/string>
+#include <sfz/sfz.hpp>
+#include <string>
+#include <vector>
+
+namespace antares {
+
+// All of the files in a data directory, in a single file, so that resources can be served as
+// slices of one mapping instead of each being found, opened, and mapped on its own.
+//
+// The pack starts with a table of contents, sorted by the hash of each file's path, so a lookup
+// is a binary search through the mapping with no parsing when the pack is opened.  All integers
+// are big-endian:
+//
+//   magic      "antpack1"
+//   count      uint32
+//   entries    count × {hash, path offset, path size, data offset, data size}, each uint32
+//   paths      the paths of the entries, relative to the directory
+//   data       the contents of the entries
+//
+// A pack takes precedence over the loose files beside it, so it must be rewritten (or removed)
+// if they change.
+class ResourcePack {
+  public:
+    // The pack's name within the directory it packs.
+    static const char kFileName[];
+
+    // Packs every regular file under `dir` into `dir`/kFileName, replacing any pack there.
+    static void write(pn::string_view dir);
+
+    // The paths of the files that write() would pack, relative to `dir`.
+    static std::vector<std::string> files(pn::string_view dir);
+
+    // Returns nullptr if `dir` has no pack.  Throws if it has one that's damaged.
+    static std::unique_ptr<ResourcePack> open(pn::string_view dir);
+
+    ResourcePack(const ResourcePack&) = delete;
+    ResourcePack& operator=(const ResourcePack&) = delete;
+
+    // Sets `data` to the contents of `path`, which is relative to the packed directory, and
+    // returns true, or returns false if it isn't in the pack.  `data` points into the pack's
+    // mapping, so it's valid for as long as the pack is.
+    bool find(pn::string_view path, pn::data_view* data) const;
+
+  private:
+    explicit ResourcePack(pn::string_view path);
+
+    uint32_t entry(uint32_t index, int field) const;
+
+    sfz::mapped_file _file;
+    uint32_t         _count;
+};
+
+}  // namespace antares
+
+#endif  // ANTARES_DATA_RESOURCE_PACK_HPP_
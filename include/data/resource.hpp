@@ -20,11 +20,19 @@
 #define ANTARES_DATA_RESOURCE_HPP_
 
 #include <stdint.h>
+#include <memory>
 #include <pn/string>
 #include <sfz/sfz.hpp>
 
 namespace antares {
 
+class ResourcePack;
+
+// A file from the first of the scenario, factory scenario, and application directories that has
+// it.  A directory's ResourcePack is searched instead of its files, if it has one.
+//
+// Each directory is indexed the first time it's searched, and the indexes are rebuilt when the
+// scenario changes, so finding a resource doesn't touch the file system until it's opened.
 class Resource {
   public:
     Resource(pn::string_view type, pn::string_view extension, int id);
@@ -34,8 +42,14 @@ class Resource {
     pn::data_view   data() const;
     pn::string_view string() const;
 
+    // How many directories are indexed, and how many times a directory was searched and did
+    // (hits) or didn't (misses) have what was looked for.
+    static pn::string stats();
+
   private:
-    std::unique_ptr<sfz::mapped_file> _file;
+    std::shared_ptr<const ResourcePack> _pack;  // if the data is in a pack,
+    std::unique_ptr<sfz::mapped_file>   _file;  // or else, if it's a loose file.
+    pn::data_view                       _data;
 };
 
 }  // namespace antares
@@ -19,6 +19,8 @@
 #ifndef ANTARES_DRAWING_INTERFACE_HPP_
 #define ANTARES_DRAWING_INTERFACE_HPP_
 
+#include <map>
+#include <memory>
 #include <pn/string>
 #include <vector>
 
@@ -27,16 +29,44 @@
 
 namespace antares {
 
+class StyledText;
+
 const int32_t kInterfaceTextVBuffer = 2;
 const int32_t kInterfaceTextHBuffer = 3;
 
 void draw_text_in_rect(
         Rect tRect, pn::string_view text, interfaceStyleType style, uint8_t textcolor);
 
+// Text drawn as by draw_text_in_rect(), but kept laid out from one draw() to the next.  It's
+// only laid out again when the text, style, color, or width changes, so text that's drawn every
+// frame isn't wrapped every frame.
+class InterfaceText {
+  public:
+    InterfaceText();
+    InterfaceText(const InterfaceText&) = delete;
+    InterfaceText& operator=(const InterfaceText&) = delete;
+    ~InterfaceText();
+
+    void draw(Rect tRect, pn::string_view text, interfaceStyleType style, uint8_t textcolor);
+
+  private:
+    pn::string                  _text;
+    interfaceStyleType          _style;
+    uint8_t                     _textcolor;
+    int32_t                     _width;
+    std::unique_ptr<StyledText> _styled;
+};
+
+// Laid-out text for the TextRects of a screen, by item.  Kept by whoever draws the items, and
+// passed to draw_interface_item() each frame.
+typedef std::map<const InterfaceItem*, InterfaceText> InterfaceTextCache;
+
 int16_t GetInterfaceTextHeightFromWidth(
         pn::string_view text, interfaceStyleType style, int16_t width);
 void draw_interface_item(const InterfaceItem& item, InputMode mode);
 void draw_interface_item(const InterfaceItem& item, InputMode mode, Point origin);
+void draw_interface_item(
+        const InterfaceItem& item, InputMode mode, Point origin, InterfaceTextCache* texts);
 
 void GetAnyInterfaceItemGraphicBounds(const InterfaceItem& item, Rect* rect);
 
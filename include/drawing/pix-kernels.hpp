@@ -0,0 +1,57 @@
+// Copyright (C) 1997, 1999-2001, 2008 Nathan Lamont
+// Copyright (C) 2008-2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#ifndef ANTARES_DRAWING_PIX_KERNELS_HPP_
+#define ANTARES_DRAWING_PIX_KERNELS_HPP_
+
+#include <stdint.h>
+
+#include "drawing/color.hpp"
+
+namespace antares {
+
+// Per-pixel loops over a row of pixels.  The scalar kernels are the reference; the SSE2 and AVX2
+// kernels must give exactly the same results, only faster.
+struct PixelKernels {
+    // Sets `count` pixels of `row` to `color`.
+    void (*fill)(RgbColor* row, int count, RgbColor color);
+
+    // Draws `count` pixels of `over` onto `under`, blending where `over` isn't opaque.
+    void (*composite)(RgbColor* under, const RgbColor* over, int count);
+
+    // Tints `count` pixels of `under` with a sprite overlay.  Each overlay pixel's red channel is
+    // the shade of `color`, and its alpha channel how much of that shade to blend in.  The alpha
+    // of `under` is unchanged.
+    void (*tint)(RgbColor* under, const RgbColor* overlay, int count, uint8_t color);
+
+    // Converts `count` pixels of BGRA bytes, as read back from OpenGL, to opaque pixels in `row`.
+    void (*from_bgra)(RgbColor* row, const uint8_t* bgra, int count);
+};
+
+extern const PixelKernels kScalarPixelKernels;
+
+// Return nullptr if the CPU (or the compiler) doesn't support the instructions.
+const PixelKernels* sse2_pixel_kernels();
+const PixelKernels* avx2_pixel_kernels();
+
+// The fastest kernels this CPU supports.
+const PixelKernels& pixel_kernels();
+
+}  // namespace antares
+
+#endif  // ANTARES_DRAWING_PIX_KERNELS_HPP_
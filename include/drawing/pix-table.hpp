@@ -19,6 +19,8 @@
 #ifndef ANTARES_DRAWING_PIX_TABLE_HPP_
 #define ANTARES_DRAWING_PIX_TABLE_HPP_
 
+#include <pn/map>
+#include <pn/string>
 #include <vector>
 
 #include "drawing/pix-map.hpp"
@@ -26,6 +28,14 @@
 
 namespace antares {
 
+class Resource;
+
+// A sprite's frames, tinted with `color` if nonzero.  If there's a cache directory, the decoded
+// and tinted frames are kept there, and reused until any of the sprite's resources change.
+//
+// The constructor only decodes frames, and may be called from any thread.  build() gives the
+// frames their textures, and must be called from the thread that owns the video driver before
+// they are drawn.
 class NatePixTable {
   public:
     class Frame;
@@ -37,19 +47,25 @@ class NatePixTable {
     NatePixTable& operator=(NatePixTable&&) = default;
     ~NatePixTable();
 
+    void build();
+
     const Frame& at(size_t index) const;
     size_t       size() const;
 
   private:
-    size_t             _size;
+    void load(pn::map_cref m, const Resource& image, const Resource& overlay, uint8_t color);
+    bool load_cached(pn::string_view path);
+    void save_cached(pn::string_view path) const;
+
+    int                _id;
     std::vector<Frame> _frames;
 };
 
 class NatePixTable::Frame {
   public:
-    Frame(Rect bounds, const PixMap& image, int16_t id, int frame);
-    Frame(Rect bounds, const PixMap& image, int16_t id, int frame, const PixMap& overlay,
-          uint8_t color);
+    Frame(Rect bounds, const PixMap& image);
+    Frame(Rect bounds, const PixMap& image, const PixMap& overlay, uint8_t color);
+    Frame(Rect bounds, ArrayPixMap&& pix_map);
     Frame(Frame&&) = default;
     ~Frame();
 
@@ -60,6 +76,8 @@ class NatePixTable::Frame {
     const Texture& texture() const;
 
   private:
+    friend class NatePixTable;
+
     void load_image(const PixMap& pix);
     void load_overlay(const PixMap& pix, uint8_t color);
     void build(int16_t id, int frame);
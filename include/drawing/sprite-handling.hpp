@@ -22,9 +22,11 @@
 #include <map>
 
 #include "data/handle.hpp"
+#include "data/pool.hpp"
 #include "drawing/color.hpp"
 #include "drawing/pix-table.hpp"
 #include "math/fixed.hpp"
+#include "math/units.hpp"
 
 namespace antares {
 
@@ -48,6 +50,7 @@ const size_t MAX_PIX_SIZE = 480;
 
 const size_t  kMaxPixTableEntry = 60;
 const int32_t kNoSprite         = -1;
+const int32_t kMaxSprite        = 500;
 
 enum spriteStyleType { spriteNormal = 0, spriteColor = 2 };
 
@@ -57,11 +60,12 @@ class Sprite {
   public:
     static Sprite*            get(int number);
     static Handle<Sprite>     none() { return Handle<Sprite>(-1); }
-    static HandleList<Sprite> all() { return HandleList<Sprite>(0, size); }
+    static HandleList<Sprite> all();
 
     Sprite();
 
     Point           where;
+    Point           last_where;  // as of the previous tick, for interpolation.
     NatePixTable*   table;
     int16_t         resID;
     int             whichShape;
@@ -74,10 +78,7 @@ class Sprite {
     RgbColor        tinyColor;
     bool            killMe;
     draw_tiny_t     draw_tiny;
-
-  private:
-    friend void         SpriteHandlingInit();
-    static const size_t size = 500;
+    PoolSlot        pool_slot;
 };
 
 extern int32_t gAbsoluteScale;
@@ -97,20 +98,46 @@ class Pix {
     NatePixTable* add(int16_t id);
     NatePixTable* get(int16_t id);
 
+    // add() is load() followed by insert().  load() may be called from any thread, and insert()
+    // only from the thread that owns the video driver.
+    static NatePixTable load(int16_t id);
+    NatePixTable*       insert(int16_t id, NatePixTable table);
+
   private:
     std::map<int16_t, NatePixTable> pix;
 };
 
-void           SpriteHandlingInit();
+void           SpriteHandlingInit(int32_t max_sprites);
 void           ResetAllSprites();
 Rect           scale_sprite_rect(const NatePixTable::Frame& frame, Point where, int32_t scale);
 Handle<Sprite> AddSprite(
         Point where, NatePixTable* table, int16_t resID, int16_t whichShape, int32_t scale,
         int32_t size, int16_t layer, const RgbColor& color);
+void SetSpriteLayer(Handle<Sprite> sprite, int16_t layer);
 void RemoveSprite(Handle<Sprite> sprite);
-void draw_sprites();
 void CullSprites();
 
+// Everything on the play screen moves once per tick, and is placed relative to the player's
+// view.  With interpolation on, the play screen is drawn between the previous tick and the
+// current one, according to how long it has been since the current tick: sprites, the
+// starfield, sector lines, vectors, labels, and the site all move together.  Motion is smooth
+// on displays faster than 60Hz, at the cost of showing the game one tick late.  Off by default,
+// so that snapshots show each tick exactly.
+void set_draw_interpolation(bool on);
+
+// How far to draw between the previous tick and the current one, in 256ths of a tick.  Always
+// 256, the current tick, with interpolation off.
+int32_t draw_progress(usecs since_tick);
+
+// Where to draw something that was at `last` on the previous tick and is at `now`.  Things that
+// move more than kMaxInterpolatedMove pixels in one tick have jumped (warped, or wrapped around
+// the edge of the screen), so they're drawn where they are, not dragged across the screen.
+const int32_t kMaxInterpolatedMove = 64;
+Point         interpolate(Point last, Point now, int32_t progress);
+
+void RememberSpritePositions();
+void draw_sprites(int32_t progress);
+
 }  // namespace antares
 
 #endif  // ANTARES_DRAWING_SPRITE_HANDLING_HPP_
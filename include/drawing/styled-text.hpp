@@ -24,11 +24,11 @@
 
 #include "drawing/color.hpp"
 #include "drawing/interface.hpp"
+#include "drawing/text.hpp"
 #include "math/geometry.hpp"
 
 namespace antares {
 
-class Font;
 class Picture;
 
 // the inline pictType struct is for keeping track of picts included in my text boxes.
@@ -48,6 +48,7 @@ class StyledText {
     void set_back_color(RgbColor back_color);
     void set_tab_width(int tab_width);
     void set_retro_text(pn::string_view text);
+    // Unlike set_retro_text(), doesn't lay out the text: call wrap_to() before drawing it.
     void set_interface_text(pn::string_view text);
     void wrap_to(int width, int side_margin, int line_spacing);
 
@@ -79,12 +80,13 @@ class StyledText {
                 uint32_t character, SpecialChar special, const RgbColor& fore_color,
                 const RgbColor& back_color);
 
-        pn::rune    character;
-        SpecialChar special;
-        RgbColor    fore_color;
-        RgbColor    back_color;
-        int         h;
-        int         v;
+        pn::rune           character;
+        SpecialChar        special;
+        RgbColor           fore_color;
+        RgbColor           back_color;
+        const Font::Glyph* glyph;  // Looked up by wrap_to(), so drawing needn't.
+        int                h;
+        int                v;
     };
 
     void color_cursor(const Rect& bounds, int index, const RgbColor& color) const;
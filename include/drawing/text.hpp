@@ -19,6 +19,7 @@
 #ifndef ANTARES_DRAWING_TEXT_HPP_
 #define ANTARES_DRAWING_TEXT_HPP_
 
+#include <map>
 #include <pn/string>
 
 #include "drawing/sprite-handling.hpp"
@@ -31,27 +32,42 @@ class Quads;
 
 class Font {
   public:
+    struct Glyph {
+        Rect bounds;   // in the font's own coordinates; size() is the size on screen.
+        Rect texture;  // in `texture`, which may be drawn at a higher scale.
+    };
+
     Font(pn::string_view name);
     Font(const Font&) = delete;
     Font& operator=(const Font&) = delete;
     ~Font();
 
+    // Returns an empty glyph if `rune` is not in the font.  The reference stays valid for the
+    // lifetime of the font.
+    const Glyph& glyph(pn::rune rune) const;
+
     uint8_t char_width(pn::rune rune) const;
     int32_t string_width(pn::string_view s) const;
 
     void draw(Point cursor, pn::string_view string, RgbColor color) const;
     void draw(const Quads& quads, Point cursor, pn::string_view string, RgbColor color) const;
 
+    // Draws `glyph` with its top-left corner at `at`, rather than its baseline.
+    void draw_glyph(const Quads& quads, Point at, const Glyph& glyph, RgbColor color) const;
+
     Texture texture;
     int32_t logicalWidth;
     int32_t height;
     int32_t ascent;
 
   private:
-    Rect glyph_rect(pn::rune rune) const;
+    // Runes below this are looked up by index, instead of in `_other_glyphs`.  Covers ASCII and
+    // Latin-1, which is every glyph in the factory fonts.
+    enum { kDenseGlyphs = 256 };
 
-    int                      _scale;
-    std::map<pn::rune, Rect> _glyphs;
+    int                       _scale;
+    Glyph                     _dense_glyphs[kDenseGlyphs];
+    std::map<pn::rune, Glyph> _other_glyphs;
 };
 
 }  // namespace antares
@@ -19,10 +19,14 @@
 #ifndef ANTARES_GAME_ACTION_HPP_
 #define ANTARES_GAME_ACTION_HPP_
 
+#include <vector>
+
 #include "data/base-object.hpp"
 
 namespace antares {
 
+class SyncHash;
+
 // Returns true iff {in,ex}clusive_filter() allows `action` to run over
 // `target`. The baseObject version uses the default attributes of the
 // object, and the spaceObject version uses the actual attributes in
@@ -36,6 +40,29 @@ void exec(
 
 void reset_action_queue();
 void execute_action_queue();
+
+// Adds every pending action to `hash`, in the order they will run.
+void hash_action_queue(SyncHash* hash);
+
+// A pending action, as saved in a checkpoint.
+struct QueuedAction {
+    HandleList<Action>  actions;
+    ticks               delay;
+    Handle<SpaceObject> subject;
+    int32_t             subject_num;
+    int32_t             subject_id;
+    Handle<SpaceObject> direct;
+    int32_t             direct_num;
+    int32_t             direct_id;
+    Point               offset;
+};
+
+// Returns every pending action, in the order they will run.
+std::vector<QueuedAction> save_action_queue();
+
+// Replaces the pending actions with `queue`, as returned by save_action_queue().
+void restore_action_queue(const std::vector<QueuedAction>& queue);
+
 }  // namespace antares
 
 #endif  // ANTARES_GAME_ACTION_HPP_
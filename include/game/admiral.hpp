@@ -61,6 +61,8 @@ enum {
     kABit32      = 1 << 31,
 };
 
+struct GlobalState;
+
 const int32_t kMaxDestObject         = 10;  // we keep special track of dest objects for AI
 const int32_t kMaxNumAdmiralCanBuild = kMaxDestObject * kMaxTypeBaseCanBuild;
 const int32_t kAdmiralScoreNum       = 3;
@@ -79,7 +81,8 @@ struct Destination {
     Handle<BaseObject>  buildObjectBaseNum;
     pn::string          name;
 
-    bool can_build() const;  // Can build anything.
+    bool        can_build() const;  // Can build anything.
+    Destination copy() const;
 };
 
 struct admiralBuildType {
@@ -92,11 +95,14 @@ class Admiral {
   public:
     static void                init();
     static void                reset();
+    static void                copy_all(const GlobalState& from, GlobalState* to);
     static Admiral*            get(int i);
     static Handle<Admiral>     make(int index, uint32_t attributes, const Level::Player& player);
     static Handle<Admiral>     none() { return Handle<Admiral>(-1); }
     static HandleList<Admiral> all() { return HandleList<Admiral>(0, kMaxPlayerNum); }
 
+    Admiral copy() const;
+
     void think();
     bool build(int32_t buildWhichType);
     void pay(Fixed howMuch);
@@ -0,0 +1,97 @@
+// Copyright (C) 1997, 1999-2001, 2008 Nathan Lamont
+// Copyright (C) 2008-2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#ifndef ANTARES_GAME_CHECKPOINT_HPP_
+#define ANTARES_GAME_CHECKPOINT_HPP_
+
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "game/action.hpp"
+#include "game/globals.hpp"
+#include "game/messages.hpp"
+#include "game/player-ship.hpp"
+#include "math/units.hpp"
+
+namespace antares {
+
+// A copy of the simulation state at the end of a major tick.  Restoring it puts the game back
+// at that tick, so that playing on from there matches the first time through.
+//
+// Only state that the simulation reads is saved.  The starfield, transitions, and sounds are
+// left as they are, and catch up with the restored game as it plays.
+class Checkpoint {
+  public:
+    explicit Checkpoint(const PlayerShip& player_ship);
+    ~Checkpoint();
+    Checkpoint(const Checkpoint&) = delete;
+    Checkpoint& operator=(const Checkpoint&) = delete;
+
+    game_ticks time() const { return _g.time; }
+    void       restore(PlayerShip* player_ship) const;
+
+  private:
+    GlobalState               _g;
+    std::vector<QueuedAction> _action_queue;
+    std::vector<uint32_t>     _condition_flags;
+    std::vector<int32_t>      _scale_history;
+    int32_t                   _absolute_scale;
+    coordPointType            _global_corner;
+    Messages::State           _messages;
+    PlayerShip::State         _player_ship;
+    hotKeyType                _hot_keys[kHotKeyNum];
+    Handle<SpaceObject>       _last_selected;
+    int32_t                   _last_selected_id;
+    game_ticks                _next_klaxon;
+};
+
+// Takes a checkpoint at least once every `interval` as the game runs, and can wind the game back
+// or forward to any of them.
+class CheckpointLog {
+  public:
+    explicit CheckpointLog(ticks interval);
+    virtual ~CheckpointLog();
+
+    // Called at the end of each major tick.  Takes a checkpoint if the last one is `interval`
+    // old, or there isn't one yet.
+    virtual void tick(PlayerShip* player_ship);
+
+    // Restores the latest checkpoint at or before `at`.  Returns false if there is none.
+    bool restore(game_ticks at, PlayerShip* player_ship);
+
+    // The time of the latest checkpoint at or before `at`, or game_ticks::min() if none.
+    game_ticks latest(game_ticks at) const;
+
+    int size() const { return _checkpoints.size(); }
+
+  private:
+    const ticks                                       _interval;
+    std::map<game_ticks, std::unique_ptr<Checkpoint>> _checkpoints;
+};
+
+// Sets the log that checkpoint_tick() reports to.  Pass nullptr to stop taking checkpoints.
+void set_checkpoint_log(CheckpointLog* log);
+
+// Lets the checkpoint log, if there is one, take a checkpoint or restore one.  Called once per
+// major tick, after trace_sync().
+void checkpoint_tick(PlayerShip* player_ship);
+
+}  // namespace antares
+
+#endif  // ANTARES_GAME_CHECKPOINT_HPP_
@@ -20,12 +20,15 @@
 #define ANTARES_GAME_GLOBALS_HPP_
 
 #include <queue>
+#include <vector>
 
 #include "config/keys.hpp"
 #include "data/handle.hpp"
 #include "data/level.hpp"
+#include "data/pool.hpp"
 #include "data/string-list.hpp"
 #include "drawing/color.hpp"
+#include "drawing/sprite-handling.hpp"
 #include "game/starfield.hpp"
 #include "math/random.hpp"
 #include "math/units.hpp"
@@ -85,13 +88,16 @@ struct GlobalState {
     std::unique_ptr<Admiral[]> admirals;  // All admirals (whether active or not).
     Handle<Admiral>            admiral;   // Local player.
 
-    std::unique_ptr<SpaceObject[]> objects;  // All space objects (whether active or not).
-    Handle<SpaceObject>            ship;     // Local player's flagship.
-    Handle<SpaceObject>            root;     // Head of LL of active objs, in creation time order.
+    Pool<SpaceObject>   objects;  // All space objects (whether active or not).
+    Handle<SpaceObject> ship;     // Local player's flagship.
+    Handle<SpaceObject> root;     // Head of LL of active objs, in creation time order.
 
     std::unique_ptr<Vector[]>      vectors;       // Auxiliary info for kIsVector objects.
     std::unique_ptr<Destination[]> destinations;  // Auxiliary info for kIsDestination objects.
-    std::unique_ptr<Sprite[]>      sprites;       // Auxiliary info for objects with sprites.
+    Pool<Sprite>                   sprites;       // Auxiliary info for objects with sprites.
+
+    // Sprites on each layer, by number in ascending order, for draw_sprites().
+    std::vector<int> sprite_layers[kLastSpriteLayer + 1];
 
     bool            game_over;     // True if an admiral won or lost the level.
     game_ticks      game_over_at;  // The time to stop the game (ignored unless game_over).
@@ -125,6 +131,10 @@ extern GlobalState& g;  // head
 extern GlobalState  head;
 extern GlobalState  tail;
 
+// Copies the simulation state in `from` to `to`, allocating any arrays that `to` is missing.
+// Radar blips are only drawn, and are refilled on the next radar pulse, so they aren't copied.
+void copy_globals(const GlobalState& from, GlobalState* to);
+
 struct aresGlobalType {
     aresGlobalType();
     ~aresGlobalType();
@@ -19,6 +19,8 @@
 #ifndef ANTARES_GAME_INSTRUMENTS_HPP_
 #define ANTARES_GAME_INSTRUMENTS_HPP_
 
+#include <vector>
+
 #include "drawing/sprite-handling.hpp"
 #include "math/units.hpp"
 
@@ -38,9 +40,9 @@ void    set_up_instruments();
 void    draw_instruments();
 void    EraseSite();
 void    update_site(bool replay);
-void    draw_site(const PlayerShip& player);
+void    draw_site(const PlayerShip& player, int32_t progress);
 void    update_sector_lines();
-void    draw_sector_lines();
+void    draw_sector_lines(int32_t progress);
 void    InstrumentsHandleClick(const GameCursor& cursor);
 void    InstrumentsHandleDoubleClick(const GameCursor& cursor);
 void    InstrumentsHandleMouseUp(const GameCursor& cursor);
@@ -50,6 +52,10 @@ void    draw_arbitrary_sector_lines(
 void GetArbitrarySingleSectorBounds(
         coordPointType*, coordPointType*, int32_t, int32_t, Rect*, Rect*);
 
+// The recent zoom scales that UpdateRadar() averages into gAbsoluteScale, oldest first.
+std::vector<int32_t> save_scale_history();
+void                 restore_scale_history(const std::vector<int32_t>& scales);
+
 }  // namespace antares
 
 #endif  // ANTARES_GAME_INSTRUMENTS_HPP_
@@ -25,6 +25,8 @@
 
 namespace antares {
 
+struct GlobalState;
+
 class Label {
   public:
     static const int32_t kNone        = -1;
@@ -37,15 +39,17 @@ class Label {
 
     static void          init();
     static void          reset();
+    static void          copy_all(const GlobalState& from, GlobalState* to);
     static Handle<Label> add(
             int16_t h, int16_t v, int16_t hoff, int16_t voff, Handle<SpaceObject> object,
             bool objectLink, uint8_t color);
-    static void draw();
+    static void draw(int32_t progress);
     static void update_contents(ticks units_done);
     static void update_positions(ticks units_done);
     static void show_all();
 
-    void remove();
+    Label copy() const;
+    void  remove();
 
     void    set_position(int16_t h, int16_t v);
     void    set_object(Handle<SpaceObject> object);
@@ -65,6 +69,7 @@ class Label {
     Point               where;
     Point               offset;
     Rect                thisRect = Rect(0, 0, -1, -1);
+    Rect                lastRect = Rect(0, 0, -1, -1);  // thisRect as of the previous tick
     int32_t             width;
     int32_t             height;
     ticks               age = ticks(0);
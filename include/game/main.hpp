@@ -38,9 +38,13 @@ enum GameResult {
 
 class MainPlay : public Card {
   public:
+    // If `headless` is true, the game skips per-tick updates that only
+    // feed into drawing the screen (starfield, labels, sector lines, and
+    // so on). Nothing the simulation depends on is skipped, so a
+    // headless replay stays in sync with a normal one.
     MainPlay(
             Handle<Level> level, bool replay, InputSource* input, bool show_loading_screen,
-            GameResult* game_result);
+            bool headless, GameResult* game_result);
 
     virtual void become_front();
 
@@ -56,6 +60,7 @@ class MainPlay : public Card {
     Handle<Level>     _level;
     const bool        _replay;
     const bool        _show_loading_screen;
+    const bool        _headless;
     bool              _cancelled;
     GameResult* const _game_result;
     InputSource*      _input_source;
@@ -19,8 +19,10 @@
 #ifndef ANTARES_GAME_MESSAGES_HPP_
 #define ANTARES_GAME_MESSAGES_HPP_
 
+#include <memory>
 #include <pn/string>
 #include <queue>
+#include <vector>
 
 #include "data/handle.hpp"
 #include "drawing/color.hpp"
@@ -58,6 +60,20 @@ class Messages {
   private:
     struct longMessageType;
 
+  public:
+    // A copy of the pending and current messages, as saved in a checkpoint.
+    struct State {
+        State();
+        ~State();
+
+        std::vector<pn::string>          message_data;
+        std::unique_ptr<longMessageType> long_message_data;
+        ticks                            time_count;
+    };
+    static void save(State* state);
+    static void restore(const State& state);
+
+  private:
     static std::queue<pn::string> message_data;
     static longMessageType*       long_message_data;
     static ticks                  time_count;
@@ -23,6 +23,8 @@
 
 namespace antares {
 
+struct GlobalState;
+
 enum MiniScreenLineKind {
     MINI_NONE       = 0,
     MINI_DIM        = 1,
@@ -47,10 +49,13 @@ struct miniScreenLineType {
     int32_t            negativeValue;
     Handle<BaseObject> sourceData;
     void (*callback)(Handle<Admiral> adm, int32_t line) = nullptr;
+
+    miniScreenLineType copy() const;
 };
 
 void  MiniScreenInit(void);
 void  MiniScreenCleanup(void);
+void  MiniScreenCopy(const GlobalState& from, GlobalState* to);
 void  SetMiniScreenStatusStrList(int16_t);
 void  DisposeMiniScreenStatusStrList(void);
 void  ClearMiniScreenLines(void);
@@ -32,9 +32,7 @@ struct adjacentUnitType {
 };
 
 struct proximityUnitType {
-    Handle<SpaceObject> nearObject;                         // for collision checking
-    Handle<SpaceObject> farObject;                          // for distance checking
-    adjacentUnitType    unitsToCheck[kUnitsToCheckNumber];  // adjacent units to check
+    adjacentUnitType unitsToCheck[kUnitsToCheckNumber];  // adjacent units to check
 };
 
 extern coordPointType gGlobalCorner;
@@ -54,6 +54,11 @@ class PlayerShip : public EventReceiver {
     GameCursor&       cursor() { return _cursor; }
     const GameCursor& cursor() const { return _cursor; }
 
+    // The player's input state, as saved in a checkpoint.
+    struct State;
+    void save(State* state) const;
+    void restore(const State& state);
+
   private:
     bool active() const;
 
@@ -78,6 +83,26 @@ class PlayerShip : public EventReceiver {
     GameCursor   _cursor;
 };
 
+// Keys held down carry over from one tick to the next.  How long the destination and hot keys
+// have been held is kept rather than when they were pressed, since restoring a checkpoint winds
+// back the game clock but not the wall clock.
+struct PlayerShip::State {
+    uint32_t     these_keys;
+    uint32_t     gamepad_keys;
+    uint32_t     key_presses;
+    uint32_t     key_releases;
+    KeyMap       keys;
+    GamepadState gamepad_state;
+    bool         control_active;
+    int32_t      control_direction;
+    int          dest_key_state;
+    usecs        dest_key_held;
+    int          hot_key_state;
+    usecs        hot_key_held;
+    int          hot_key_num;
+    int          previous_zoom;
+};
+
 void ResetPlayerShip(Handle<SpaceObject> which);
 void PlayerShipHandleClick(Point where, int button);
 void SetPlayerSelectShip(
@@ -35,15 +35,10 @@ enum dutyType {
 
 class SpaceObject {
   public:
-    static SpaceObject* get(int number) {
-        if ((0 <= number) && (number < kMaxSpaceObject)) {
-            return &g.objects[number];
-        }
-        return nullptr;
-    }
-
+    static SpaceObject*            get(int number) { return g.objects.get(number); }
     static Handle<SpaceObject>     none() { return Handle<SpaceObject>(-1); }
-    static HandleList<SpaceObject> all() { return HandleList<SpaceObject>(0, kMaxSpaceObject); }
+    static HandleList<SpaceObject> all() { return HandleList<SpaceObject>(0, g.objects.size()); }
+    static int32_t                 capacity() { return g.objects.capacity(); }
 
     SpaceObject() = default;
     SpaceObject(
@@ -69,6 +64,7 @@ class SpaceObject {
     BaseObject*        baseType   = nullptr;
     Handle<BaseObject> base;
     int32_t            number() const;
+    PoolSlot           pool_slot;
 
     uint32_t keysDown = 0;
 
@@ -84,7 +80,6 @@ class SpaceObject {
 
     coordPointType      location = {0, 0};
     Point               collisionGrid;
-    Handle<SpaceObject> nextNearObject;
     Point               distanceGrid;
     Handle<SpaceObject> nextFarObject;
     Handle<SpaceObject> previousObject;
@@ -214,7 +209,7 @@ class SpaceObject {
     uint8_t originalColor = 0;
 };
 
-void SpaceObjectHandlingInit(void);
+void SpaceObjectHandlingInit(int32_t max_objects);
 void ResetAllSpaceObjects(void);
 void RemoveAllSpaceObjects(void);
 
@@ -65,7 +65,7 @@ class Starfield {
             Point* location);
     void prepare_to_move();
     void move(ticks by_units);
-    void draw() const;
+    void draw(int32_t progress) const;
     void show();
 
   private:
@@ -0,0 +1,110 @@
+// Copyright (C) 1997, 1999-2001, 2008 Nathan Lamont
+// Copyright (C) 2008-2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#ifndef ANTARES_GAME_SYNC_TRACE_HPP_
+#define ANTARES_GAME_SYNC_TRACE_HPP_
+
+#include <stdint.h>
+#include <pn/file>
+#include <pn/string>
+#include <vector>
+
+namespace antares {
+
+// A 32-bit FNV-1a hash, fed one integer at a time.
+class SyncHash {
+  public:
+    void     add(int64_t value);
+    uint32_t value() const { return _value; }
+
+  private:
+    uint32_t _value = 2166136261u;
+};
+
+// Hashes of the simulation state at the end of one major tick.  Each field covers one slice of
+// the state, so when two runs of a replay diverge, the first field that differs points at the
+// cause.
+struct SyncRecord {
+    enum Field {
+        TIME,
+        RANDOM,
+        OBJECT_SLOTS,
+        OBJECT_LOCATION,
+        OBJECT_MOTION,
+        OBJECT_HEALTH,
+        OBJECT_TARGETS,
+        OBJECT_STATE,
+        OBJECT_RANDOM,
+        OBJECT_WEAPONS,
+        ADMIRALS,
+        DESTINATIONS,
+        ACTION_QUEUE,
+        FIELD_COUNT,
+    };
+
+    int64_t  tick;
+    uint32_t hashes[FIELD_COUNT];
+
+    static SyncRecord      current();
+    static pn::string_view field_name(int field);
+};
+
+class SyncTrace {
+  public:
+    virtual ~SyncTrace();
+    virtual void record(const SyncRecord& record) = 0;
+};
+
+// Writes every record to a trace file.
+class SyncTraceWriter : public SyncTrace {
+  public:
+    explicit SyncTraceWriter(pn::string_view path);
+    virtual void record(const SyncRecord& record);
+
+  private:
+    pn::file _file;
+    int64_t  _last_tick = 0;
+};
+
+// Compares every record against a trace file written by an earlier run, and keeps track of the
+// first tick and field that differ.  A run that ends early or runs long is out of sync too.
+class SyncTraceVerifier : public SyncTrace {
+  public:
+    explicit SyncTraceVerifier(pn::string_view path);
+    virtual void record(const SyncRecord& record);
+
+    bool       in_sync() const;
+    pn::string report() const;
+
+  private:
+    std::vector<SyncRecord> _golden;
+    size_t                  _checked  = 0;
+    bool                    _diverged = false;
+    int64_t                 _tick     = 0;
+    pn::string              _field;
+};
+
+// Sets the trace that trace_sync() records to.  Pass nullptr to stop tracing.
+void set_sync_trace(SyncTrace* trace);
+
+// Records the current state to the trace, if there is one.  Called once per major tick.
+void trace_sync();
+
+}  // namespace antares
+
+#endif  // ANTARES_GAME_SYNC_TRACE_HPP_
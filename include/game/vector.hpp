@@ -28,6 +28,7 @@
 namespace antares {
 
 class SpaceObject;
+struct GlobalState;
 
 static const int kBoltPointNum = 10;
 
@@ -48,6 +49,8 @@ struct Vector {
 
     uint8_t             vectorKind;
     Rect                thisLocation;
+    Rect                lastLocation;  // thisLocation as of the previous tick
+    bool                located;       // whether update() has placed it yet
     coordPointType      lastGlobalLocation;
     coordPointType      objectLocation;
     coordPointType      lastApparentLocation;
@@ -74,12 +77,13 @@ class Vectors {
   public:
     static void           init();
     static void           reset();
+    static void           copy_all(const GlobalState& from, GlobalState* to);
     static Handle<Vector> add(
             coordPointType* location, uint8_t color, uint8_t kind, int32_t accuracy,
             int32_t vector_range);
     static void set_attributes(Handle<SpaceObject> vectorObject, Handle<SpaceObject> sourceObject);
     static void update();
-    static void draw();
+    static void draw(int32_t progress);
     static void show_all();
     static void cull();
 };
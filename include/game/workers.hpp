@@ -0,0 +1,41 @@
+// Copyright (C) 1997, 1999-2001, 2008 Nathan Lamont
+// Copyright (C) 2008-2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#ifndef ANTARES_GAME_WORKERS_HPP_
+#define ANTARES_GAME_WORKERS_HPP_
+
+#include <functional>
+
+namespace antares {
+
+// Sets the number of threads that parallel_for() spreads work across, including the calling
+// thread.  The default, 1, runs everything on the calling thread.
+//
+// Work split with parallel_for() must produce the same result regardless of thread count, so
+// that replays stay in sync; the thread count only changes how fast the simulation runs.
+void set_worker_threads(int threads);
+int  worker_threads();
+
+// Calls `task(0)` through `task(count - 1)`, spread across the worker threads, and returns once
+// all of them have finished.  Tasks may run in any order and on any thread, so each task should
+// write only to its own outputs, which the caller then combines in task order.
+void parallel_for(int count, const std::function<void(int)>& task);
+
+}  // namespace antares
+
+#endif  // ANTARES_GAME_WORKERS_HPP_
@@ -19,6 +19,8 @@
 #ifndef ANTARES_GLFW_VIDEO_DRIVER_HPP_
 #define ANTARES_GLFW_VIDEO_DRIVER_HPP_
 
+#include <stdint.h>
+#include <pn/string>
 #include <queue>
 #include <stack>
 
@@ -46,9 +48,25 @@ class GLFWVideoDriver : public OpenGlVideoDriver {
 
     virtual wall_time now() const;
 
+    // With vsync, buffer swaps wait for the display's refresh, and a frame is drawn for every
+    // refresh, whether or not anything has happened.  Without it, frames are shown as soon as
+    // they're drawn.
+    void set_vsync(bool vsync) { _vsync = vsync; }
+
+    // Runs until the card stack is empty or the window is closed.  Waits between frames for
+    // input or the top card's next timer, whichever comes first.  Without vsync, only redraws
+    // when one of them has arrived; with it, also stops waiting at the display's next refresh,
+    // and redraws then.
     void loop(Card* initial);
 
+    // How long frames took to draw and swap, in power-of-two millisecond buckets, and how many
+    // draw calls they took on average.
+    pn::string frame_times() const;
+
   private:
+    enum { kFrameTimeBuckets = 8 };
+
+    void        draw_frame();
     void        key(int key, int scancode, int action, int mods);
     void        mouse_button(int button, int action, int mods);
     void        mouse_move(double x, double y);
@@ -57,6 +75,7 @@ class GLFWVideoDriver : public OpenGlVideoDriver {
     static void mouse_button_callback(GLFWwindow* w, int button, int action, int mods);
     static void mouse_move_callback(GLFWwindow* w, double x, double y);
     static void window_size_callback(GLFWwindow* w, int width, int height);
+    static void window_refresh_callback(GLFWwindow* w);
 
     Size        _screen_size;
     Size        _viewport_size;
@@ -64,6 +83,11 @@ class GLFWVideoDriver : public OpenGlVideoDriver {
     MainLoop*   _loop;
     wall_time   _last_click_usecs;
     int         _last_click_count;
+    bool        _vsync = false;
+    usecs       _refresh_interval;  // Of the display, with vsync.
+    wall_time   _last_frame;        // When the last frame started drawing.
+    bool        _dirty = true;  // Set when an event or timer may have changed the screen.
+    int64_t     _frame_times[kFrameTimeBuckets] = {};
 };
 
 }  // namespace antares
@@ -37,6 +37,16 @@ class Sound {
     virtual void loop() = 0;
 };
 
+// A sound read and decoded by SoundDriver::decode_sound(), but not yet opened.
+class DecodedSound {
+  public:
+    DecodedSound() {}
+    DecodedSound(const DecodedSound&) = delete;
+    DecodedSound& operator=(const DecodedSound&) = delete;
+
+    virtual ~DecodedSound() {}
+};
+
 class SoundChannel {
   public:
     SoundChannel() {}
@@ -58,9 +68,15 @@ class SoundDriver {
 
     virtual ~SoundDriver();
 
-    virtual std::unique_ptr<SoundChannel> open_channel()            = 0;
-    virtual std::unique_ptr<Sound> open_sound(pn::string_view path) = 0;
-    virtual void set_global_volume(uint8_t volume)                  = 0;
+    virtual std::unique_ptr<SoundChannel> open_channel() = 0;
+    virtual void set_global_volume(uint8_t volume)       = 0;
+
+    // Opening a sound is split in two, so that the slow part can be spread across threads:
+    // decode_sound() may be called from any thread, but open_sound() only from the thread that
+    // owns the driver.
+    virtual std::unique_ptr<DecodedSound> decode_sound(pn::string_view path) = 0;
+    virtual std::unique_ptr<Sound> open_sound(std::unique_ptr<DecodedSound> decoded) = 0;
+    std::unique_ptr<Sound> open_sound(pn::string_view path);
 
     static SoundDriver* driver();
 };
@@ -72,8 +88,11 @@ class NullSoundDriver : public SoundDriver {
     NullSoundDriver& operator=(const NullSoundDriver&) = delete;
 
     virtual std::unique_ptr<SoundChannel> open_channel();
-    virtual std::unique_ptr<Sound> open_sound(pn::string_view path);
     virtual void set_global_volume(uint8_t volume);
+
+    using SoundDriver::open_sound;
+    virtual std::unique_ptr<DecodedSound> decode_sound(pn::string_view path);
+    virtual std::unique_ptr<Sound> open_sound(std::unique_ptr<DecodedSound> decoded);
 };
 
 class LogSoundDriver : public SoundDriver {
@@ -81,12 +100,16 @@ class LogSoundDriver : public SoundDriver {
     LogSoundDriver(pn::string_view path);
 
     virtual std::unique_ptr<SoundChannel> open_channel();
-    virtual std::unique_ptr<Sound> open_sound(pn::string_view path);
     virtual void set_global_volume(uint8_t volume);
 
+    using SoundDriver::open_sound;
+    virtual std::unique_ptr<DecodedSound> decode_sound(pn::string_view path);
+    virtual std::unique_ptr<Sound> open_sound(std::unique_ptr<DecodedSound> decoded);
+
   private:
     class LogSound;
     class LogChannel;
+    class LogDecodedSound;
 
     pn::file    _sound_log;
     int         _last_id;
@@ -21,6 +21,7 @@
 
 #include <stdint.h>
 
+#include <memory>
 #include <vector>
 
 #include "data/handle.hpp"
@@ -29,6 +30,8 @@
 
 namespace antares {
 
+class DecodedSound;
+
 const int32_t kMaxVolumePreference = 8;
 
 class SoundFX {
@@ -39,6 +42,12 @@ class SoundFX {
     void init();
     void load(int16_t id);
     void reset();
+
+    // load() is decode() followed by insert().  decode() may be called from any thread, and
+    // insert() only from the thread that owns the sound driver.
+    bool                                 loaded(int16_t id) const;
+    static std::unique_ptr<DecodedSound> decode(int16_t id);
+    void insert(int16_t id, std::unique_ptr<DecodedSound> decoded);
     void stop();
 
     void play(int16_t id, uint8_t volume, usecs persistence, uint8_t priority);
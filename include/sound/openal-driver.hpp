@@ -39,15 +39,19 @@ class OpenAlSoundDriver : public SoundDriver {
     ~OpenAlSoundDriver();
 
     virtual std::unique_ptr<SoundChannel> open_channel();
-    virtual std::unique_ptr<Sound>        open_sound(pn::string_view path);
     virtual void                          set_global_volume(uint8_t volume);
 
+    using SoundDriver::open_sound;
+    virtual std::unique_ptr<DecodedSound> decode_sound(pn::string_view path);
+    virtual std::unique_ptr<Sound>        open_sound(std::unique_ptr<DecodedSound> decoded);
+
   private:
     class OpenAlChannel;
     class OpenAlSound;
+    class OpenAlDecodedSound;
 
     template <typename T>
-    static void read_sound(pn::data_view data, OpenAlSound& sound);
+    static void read_sound(pn::data_view data, OpenAlDecodedSound& sound);
 
     ALCcontext*    _context;
     ALCdevice*     _device;
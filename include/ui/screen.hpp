@@ -76,6 +76,7 @@ class InterfaceScreen : public Card {
     const Rect                                  _bounds;
     const bool                                  _full_screen;
     std::vector<std::unique_ptr<InterfaceItem>> _items;
+    mutable InterfaceTextCache                  _texts;
     Button*                                     _hit_button;
     uint32_t                                    _pressed;
     Cursor                                      _cursor;
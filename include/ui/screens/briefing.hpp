@@ -87,6 +87,7 @@ class BriefingScreen : public InterfaceScreen {
     Rect                                 _highlight_rect;
     std::vector<std::pair<Point, Point>> _highlight_lines;
     pn::string                           _text;
+    mutable InterfaceText                _text_layout;
 };
 
 }  // namespace antares
@@ -62,6 +62,15 @@ class VideoDriver {
     virtual wall_time now() const = 0;
 
     virtual Texture texture(pn::string_view name, const PixMap& content) = 0;
+
+    // Like texture(), but for small images that are drawn often, like sprite frames and font
+    // glyphs.  The driver may pack them into shared pages, so that drawing several of them needs
+    // fewer texture switches.
+    virtual Texture atlas_texture(pn::string_view name, const PixMap& content);
+
+    // Describes how full the pages used by atlas_texture() are, or is empty if there are none.
+    virtual pn::string atlas_stats() const;
+
     virtual void dither_rect(const Rect& rect, const RgbColor& color)    = 0;
     virtual void draw_point(const Point& at, const RgbColor& color)      = 0;
     virtual void draw_line(const Point& from, const Point& to, const RgbColor& color) = 0;
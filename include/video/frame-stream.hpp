@@ -0,0 +1,68 @@
+// Copyright (C) 1997, 1999-2001, 2008 Nathan Lamont
+// Copyright (C) 2008-2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#ifndef ANTARES_VIDEO_FRAME_STREAM_HPP_
+#define ANTARES_VIDEO_FRAME_STREAM_HPP_
+
+#include <pn/data>
+#include <pn/file>
+#include <pn/string>
+
+#include "math/geometry.hpp"
+
+namespace antares {
+
+class PixMap;
+
+// Writes snapshots as uncompressed video, for an encoder like ffmpeg to read directly:
+//
+//   * Y4M is a YUV4MPEG2 stream, with full-resolution chroma (C444) in BT.601 studio range.
+//   * RGB is headerless rgb24, top row first; the reader has to be told the size and rate.
+//
+// frame() may be called from any thread; write() must be called in frame order.
+class FrameStream {
+  public:
+    enum Format {
+        Y4M,
+        RGB,
+    };
+
+    // Parses "y4m" or "rgb".  Throws if `name` is neither.
+    static Format format(pn::string_view name);
+
+    // `frame_ticks` is the number of ticks between frames; ticks are 1/60 second.
+    FrameStream(pn::file_view out, Format format, Size size, int frame_ticks);
+    FrameStream(const FrameStream&) = delete;
+    FrameStream& operator=(const FrameStream&) = delete;
+
+    const Size& size() const { return _size; }
+
+    // Converts `pix`, which must be `size()`, to a frame of the stream.
+    pn::data frame(const PixMap& pix) const;
+
+    void write(pn::data_view frame);
+
+  private:
+    pn::file_view _out;
+    const Format  _format;
+    const Size    _size;
+};
+
+}  // namespace antares
+
+#endif  // ANTARES_VIDEO_FRAME_STREAM_HPP_
@@ -23,11 +23,14 @@
 #include <sfz/sfz.hpp>
 
 #include "config/keys.hpp"
+#include "math/units.hpp"
 #include "ui/event-scheduler.hpp"
 #include "video/opengl-driver.hpp"
 
 namespace antares {
 
+class FrameStream;
+
 class OffscreenVideoDriver : public OpenGlVideoDriver {
     class MainLoop;
 
@@ -46,10 +49,20 @@ class OffscreenVideoDriver : public OpenGlVideoDriver {
     void capture(std::vector<std::pair<std::unique_ptr<Card>, pn::string>>& pix);
     void set_capture_rect(Rect r) { _capture_rect = r; }
 
+    // Sends snapshots to `stream`, instead of to PNG files in the output directory.
+    void set_stream(FrameStream* stream) { _stream = stream; }
+
+    // The frames drawn so far, with their draw calls and the wall time spent drawing them, for
+    // comparing drawing performance without a display.
+    pn::string frame_stats() const;
+
   private:
     const Size                _screen_size;
     sfz::optional<pn::string> _output_dir;
     Rect                      _capture_rect;
+    FrameStream*              _stream = nullptr;
+    int64_t                   _frames = 0;
+    usecs                     _draw_time{0};
 
     EventScheduler* _scheduler = nullptr;
 };
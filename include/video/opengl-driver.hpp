@@ -21,6 +21,8 @@
 
 #include <stdint.h>
 #include <map>
+#include <memory>
+#include <vector>
 
 #include "drawing/color.hpp"
 #include "math/geometry.hpp"
@@ -53,16 +55,22 @@ struct Uniform {
 class OpenGlVideoDriver : public VideoDriver {
   public:
     OpenGlVideoDriver();
+    virtual ~OpenGlVideoDriver();
 
     virtual int scale() const;
 
-    virtual Texture texture(pn::string_view name, const PixMap& content);
-    virtual void    dither_rect(const Rect& rect, const RgbColor& color);
-    virtual void    draw_point(const Point& at, const RgbColor& color);
-    virtual void    draw_line(const Point& from, const Point& to, const RgbColor& color);
-    virtual void    draw_triangle(const Rect& rect, const RgbColor& color);
-    virtual void    draw_diamond(const Rect& rect, const RgbColor& color);
-    virtual void    draw_plus(const Rect& rect, const RgbColor& color);
+    virtual Texture    texture(pn::string_view name, const PixMap& content);
+    virtual Texture    atlas_texture(pn::string_view name, const PixMap& content);
+    virtual pn::string atlas_stats() const;
+    virtual void       dither_rect(const Rect& rect, const RgbColor& color);
+    virtual void       draw_point(const Point& at, const RgbColor& color);
+    virtual void       draw_line(const Point& from, const Point& to, const RgbColor& color);
+    virtual void       draw_triangle(const Rect& rect, const RgbColor& color);
+    virtual void       draw_diamond(const Rect& rect, const RgbColor& color);
+    virtual void       draw_plus(const Rect& rect, const RgbColor& color);
+
+    // The number of draw calls made so far, for comparing how well batching works.
+    int64_t draw_calls() const;
 
     struct Uniforms {
         Uniform<vec2>          screen          = {"screen"};
@@ -73,9 +81,17 @@ class OpenGlVideoDriver : public VideoDriver {
         Uniform<float>         static_fraction = {"static_fraction"};
         Uniform<vec2>          unit            = {"unit"};
         Uniform<vec4>          outline_color   = {"outline_color"};
+        Uniform<vec4>          sprite_bounds   = {"sprite_bounds"};
         Uniform<int>           seed            = {"seed"};
     };
 
+    // Collects vertices in a streaming buffer, and draws them with a single call once the
+    // shader or texture state changes, or the frame ends.
+    class Batch;
+
+    // A texture object holding one image, or several packed into an atlas page.
+    class Sheet;
+
   protected:
     class MainLoop {
       public:
@@ -99,27 +115,31 @@ class OpenGlVideoDriver : public VideoDriver {
     virtual Size viewport_size() const = 0;
 
   private:
+    // Pages are the smallest size that every GL 3.3 implementation must support for rectangle
+    // textures.  Larger images get sheets of their own.
+    enum {
+        kAtlasPageSize     = 1024,
+        kMaxAtlasImageSize = 256,
+    };
+
     virtual void begin_points();
-    virtual void end_points();
     virtual void batch_point(const Point& at, const RgbColor& color);
-
     virtual void begin_lines();
-    virtual void end_lines();
     virtual void batch_line(const Point& from, const Point& to, const RgbColor& color);
-
-    virtual void begin_rects();
-    virtual void end_rects();
     virtual void batch_rect(const Rect& rect, const RgbColor& color);
 
     Random _static_seed;
 
-    Uniforms _uniforms;
+    // Shared with textures, which may outlive the driver.  The batch loads uniforms as it flushes,
+    // including when a texture is deleted, so it shares them too.
+    std::shared_ptr<Uniforms> _uniforms;
+    std::shared_ptr<Batch>    _batch;
 
     std::map<size_t, Texture> _triangles;
     std::map<size_t, Texture> _diamonds;
     std::map<size_t, Texture> _pluses;
 
-    uint32_t _vbuf[3];
+    std::vector<std::shared_ptr<Sheet>> _atlas;
 };
 
 }  // namespace antares
@@ -0,0 +1,104 @@
+// Copyright (C) 1997, 1999-2001, 2008 Nathan Lamont
+// Copyright (C) 2008-2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#ifndef ANTARES_VIDEO_SOFTWARE_DRIVER_HPP_
+#define ANTARES_VIDEO_SOFTWARE_DRIVER_HPP_
+
+#include <map>
+#include <memory>
+#include <pn/string>
+#include <sfz/sfz.hpp>
+#include <vector>
+
+#include "config/keys.hpp"
+#include "drawing/pix-map.hpp"
+#include "math/random.hpp"
+#include "ui/event-scheduler.hpp"
+#include "video/driver.hpp"
+
+namespace antares {
+
+class FrameStream;
+
+// Renders on the CPU into an ArrayPixMap, following the same rules as the OpenGL driver's
+// shaders, so it can take snapshots without a GPU or a display server.  Output matches the
+// OffscreenVideoDriver closely, but not always to the bit: edges of scaled sprites and blending
+// may round differently.
+class SoftwareVideoDriver : public VideoDriver {
+  public:
+    SoftwareVideoDriver(Size screen_size, const sfz::optional<pn::string>& output_dir);
+    virtual ~SoftwareVideoDriver();
+
+    virtual Point     get_mouse() { return _scheduler->get_mouse(); }
+    virtual InputMode input_mode() const { return _scheduler->input_mode(); }
+    virtual int       scale() const { return 1; }
+    virtual Size      screen_size() const { return _screen_size; }
+
+    virtual wall_time now() const { return _scheduler->now(); }
+
+    virtual Texture texture(pn::string_view name, const PixMap& content);
+    virtual void    dither_rect(const Rect& rect, const RgbColor& color);
+    virtual void    draw_point(const Point& at, const RgbColor& color);
+    virtual void    draw_line(const Point& from, const Point& to, const RgbColor& color);
+    virtual void    draw_triangle(const Rect& rect, const RgbColor& color);
+    virtual void    draw_diamond(const Rect& rect, const RgbColor& color);
+    virtual void    draw_plus(const Rect& rect, const RgbColor& color);
+
+    void loop(Card* initial, EventScheduler& scheduler);
+    void capture(std::vector<std::pair<std::unique_ptr<Card>, pn::string>>& pix);
+    void set_capture_rect(Rect r) { _capture_rect = r; }
+
+    // Sends snapshots to `stream`, instead of to PNG files in the output directory.
+    void set_stream(FrameStream* stream) { _stream = stream; }
+
+  private:
+    class MainLoop;
+    class TextureImpl;
+
+    virtual void batch_point(const Point& at, const RgbColor& color);
+    virtual void batch_line(const Point& from, const Point& to, const RgbColor& color);
+    virtual void batch_rect(const Rect& rect, const RgbColor& color);
+
+    void blend(int32_t x, int32_t y, const RgbColor& color);
+    bool static_at(int32_t x, int32_t y, uint8_t frac) const;
+    void draw_shape(
+            std::map<int32_t, Texture>& cache, void (*draw)(PixMap*, const RgbColor&),
+            const Rect& rect, const RgbColor& color);
+
+    const Size                _screen_size;
+    sfz::optional<pn::string> _output_dir;
+    Rect                      _capture_rect;
+    FrameStream*              _stream = nullptr;
+    ArrayPixMap               _pix;
+
+    // The OpenGL driver's static texture: one random byte per texel, and a random offset into it
+    // for each frame.
+    std::unique_ptr<uint8_t[]> _static_image;
+    Random                     _static_seed;
+    int32_t                    _seed = 0;
+
+    std::map<int32_t, Texture> _triangles;
+    std::map<int32_t, Texture> _diamonds;
+    std::map<int32_t, Texture> _pluses;
+
+    EventScheduler* _scheduler = nullptr;
+};
+
+}  // namespace antares
+
+#endif  // ANTARES_VIDEO_SOFTWARE_DRIVER_HPP_
@@ -71,6 +71,89 @@ def replay_test(opts, queue, name, args=[]):
     return diff_test(queue, name, cmd + args, expected)
 
 
+# The software driver doesn't reproduce the GL driver bit for bit; it rounds blending and
+# sampling differently.  Each channel of each pixel may differ by this much.
+SOFTWARE_TOLERANCE = 8
+
+
+def png_diff(queue, name, expected, actual):
+    expected_pngs = sorted(
+        os.path.relpath(os.path.join(root, f), expected)
+        for root, _, files in os.walk(expected) for f in files if f.endswith(".png"))
+    actual_pngs = sorted(
+        os.path.relpath(os.path.join(root, f), actual)
+        for root, _, files in os.walk(actual) for f in files if f.endswith(".png"))
+    if expected_pngs != actual_pngs:
+        print("expected images:\n%s\nactual images:\n%s" %
+              ("\n".join(expected_pngs), "\n".join(actual_pngs)))
+        return False
+    if not expected_pngs:
+        print("no images in %s" % expected)
+        return False
+    for png in expected_pngs:
+        if not run(queue, name, ["out/cur/png-diff", "--tolerance=%d" % SOFTWARE_TOLERANCE,
+                                 os.path.join(expected, png), os.path.join(actual, png)]):
+            return False
+    return True
+
+
+def software_offscreen_test(opts, queue, name, script):
+    with NamedTemporaryDir() as d:
+        cmd = ["out/cur/offscreen", script, "--software", "--output=%s" % d]
+        return run(queue, name, cmd) and png_diff(queue, name, "test/%s" % script, d)
+
+
+def software_replay_test(opts, queue, name, replay):
+    # There are no golden images of replays, so compare against the GL driver's.
+    with NamedTemporaryDir() as gl, NamedTemporaryDir() as software:
+        cmd = ["out/cur/replay", "test/%s.NLRP" % replay, "--interval=600"]
+        return (run(queue, name, cmd + ["--output=%s" % gl]) and
+                run(queue, name, cmd + ["--software", "--output=%s" % software]) and
+                png_diff(queue, name, gl, software))
+
+
+def threads_test(opts, queue, name, replays):
+    # calc_locality() splits its pairwise checks across worker threads; the outcome of a replay
+    # must not depend on how many there are.
+    # Lines of antares-sim output that vary from run to run, or with the thread count.
+    timing = ["threads", "elapsed", "ticks/sec", "trace"]
+    for replay in replays:
+        with NamedTemporaryDir() as d:
+            trace = os.path.join(d, "%s.trace" % replay)
+            outputs = []
+            for threads in [1, 2, 4, 8]:
+                cmd = ["out/cur/antares-sim", "test/%s.NLRP" % replay, "--threads=%d" % threads]
+                if threads == 1:
+                    cmd.append("--trace=%s" % trace)
+                else:
+                    cmd.append("--verify=%s" % trace)
+                sub = subprocess.Popen(cmd, stdout=subprocess.PIPE, stderr=subprocess.STDOUT)
+                output, _ = sub.communicate()
+                if sub.returncode != 0:
+                    print("%s with %d threads failed:\n%s" % (replay, threads, output))
+                    return False
+                lines = [l for l in output.splitlines() if l.split(":")[0] not in timing]
+                outputs.append((threads, lines))
+            for threads, lines in outputs[1:]:
+                if lines != outputs[0][1]:
+                    print("%s differs with %d threads:\n%s\nvs. 1 thread:\n%s" %
+                          (replay, threads, "\n".join(lines), "\n".join(outputs[0][1])))
+                    return False
+    return True
+
+
+def seek_test(opts, queue, name, replays):
+    # Seeking back to a tick restores a checkpoint, and must find the same state there as the
+    # first time through; the replay binary checks this itself.
+    seeks = [1800, 300, 1800, 1200]
+    for replay in replays:
+        cmd = ["out/cur/replay", "test/%s.NLRP" % replay, "--smoke", "--checkpoint-interval=600"]
+        cmd += ["--seek=%d" % tick for tick in seeks]
+        if not run(queue, name, cmd):
+            return False
+    return True
+
+
 def call(args):
     fn = args[0]
     opts = args[1]
@@ -112,7 +195,7 @@ def main():
     # Install or reinstall data/scenarios if it’s missing or out-of-date.
     subprocess.check_call("out/cur/antares-install-data -d data/scenarios".split())
 
-    test_types = "unit data offscreen replay".split()
+    test_types = "unit data offscreen replay software threads seek".split()
     parser = argparse.ArgumentParser()
     parser.add_argument("--smoke", action="store_true")
     parser.add_argument("-t", "--type", action="append", choices=test_types)
@@ -123,6 +206,10 @@ def main():
     pool = multiprocessing.pool.ThreadPool()
     tests = [
         (unit_test, opts, queue, "fixed-test"),
+        (unit_test, opts, queue, "pix-kernels-test"),
+        (unit_test, opts, queue, "pix-table-test"),
+        (unit_test, opts, queue, "resource-pack-test"),
+        (unit_test, opts, queue, "special-test"),
         (data_test, opts, queue, "build-pix", [], ["--text"]),
         (data_test, opts, queue, "object-data"),
         (data_test, opts, queue, "shapes"),
@@ -147,6 +234,12 @@ def main():
         (replay_test, opts, queue, "while-the-iron-is-hot"),
         (replay_test, opts, queue, "yo-ho-ho"),
         (replay_test, opts, queue, "you-should-have-seen-the-one-that-got-away"),
+        (software_offscreen_test, opts, queue, "software-main-screen", "main-screen"),
+        (software_offscreen_test, opts, queue, "software-options", "options"),
+        (software_replay_test, opts, queue, "software-space-race", "space-race"),
+        (threads_test, opts, queue, "sim-threads",
+         ["hornets-nest", "space-race", "the-mothership-connection"]),
+        (seek_test, opts, queue, "replay-seek", ["hornets-nest", "space-race"]),
     ]
 
     if opts.test:
@@ -162,6 +255,15 @@ def main():
             tests = [t for t in tests if t[0] != offscreen_test]
         if "replay" not in opts.type:
             tests = [t for t in tests if t[0] != replay_test]
+        if "threads" not in opts.type:
+            tests = [t for t in tests if t[0] != threads_test]
+        if "seek" not in opts.type:
+            tests = [t for t in tests if t[0] != seek_test]
+
+    # The software driver's output hasn't been checked against the GL driver's yet, so its tests
+    # only run when asked for, with -t software or by name.
+    if not opts.test and ("software" not in (opts.type or [])):
+        tests = [t for t in tests if t[0] not in [software_offscreen_test, software_replay_test]]
 
     sys.stderr.write("Running %d tests:\n" % len(tests))
     start = time.time()
@@ -29,6 +29,7 @@
 #include "ui/flows/master.hpp"
 #include "video/driver.hpp"
 #include "video/offscreen-driver.hpp"
+#include "video/software-driver.hpp"
 #include "video/text-driver.hpp"
 
 using sfz::makedirs;
@@ -60,6 +61,7 @@ void usage(pn::file_view out, pn::string_view progname, int retcode) {
             "options:\n"
             " -o, --output=OUTPUT place output in this directory\n"
             " -t, --text          produce text output\n"
+            "     --software      render on the CPU, without OpenGL\n"
             " -h, --help          display this help screen\n",
             progname);
     exit(retcode);
@@ -90,18 +92,23 @@ void main(int argc, char* const* argv) {
         }
     };
 
-    callbacks.long_option =
-            [&callbacks](pn::string_view opt, const args::callbacks::get_value_f& get_value) {
-                if (opt == "output") {
-                    return callbacks.short_option(pn::rune{'o'}, get_value);
-                } else if (opt == "text") {
-                    return callbacks.short_option(pn::rune{'t'}, get_value);
-                } else if (opt == "help") {
-                    return callbacks.short_option(pn::rune{'h'}, get_value);
-                } else {
-                    return false;
-                }
-            };
+    bool software         = false;
+    callbacks.long_option = [&callbacks, &software](
+                                    pn::string_view                     opt,
+                                    const args::callbacks::get_value_f& get_value) {
+        if (opt == "output") {
+            return callbacks.short_option(pn::rune{'o'}, get_value);
+        } else if (opt == "text") {
+            return callbacks.short_option(pn::rune{'t'}, get_value);
+        } else if (opt == "software") {
+            software = true;
+            return true;
+        } else if (opt == "help") {
+            return callbacks.short_option(pn::rune{'h'}, get_value);
+        } else {
+            return false;
+        }
+    };
 
     args::parse(argc - 1, argv + 1, callbacks);
 
@@ -138,6 +145,9 @@ void main(int argc, char* const* argv) {
     if (text) {
         TextVideoDriver video({640, 480}, output_dir);
         video.loop(new Master(14586), scheduler);
+    } else if (software) {
+        SoftwareVideoDriver video({640, 480}, output_dir);
+        video.loop(new Master(14586), scheduler);
     } else {
         OffscreenVideoDriver video({640, 480}, output_dir);
         video.loop(new Master(14586), scheduler);
@@ -0,0 +1,159 @@
+// Copyright (C) 1997, 1999-2001, 2008 Nathan Lamont
+// Copyright (C) 2008-2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#include <stdlib.h>
+#include <algorithm>
+#include <pn/file>
+#include <sfz/sfz.hpp>
+
+#include "drawing/pix-map.hpp"
+
+namespace args = sfz::args;
+
+namespace antares {
+namespace {
+
+void usage(pn::file_view out, pn::string_view progname, int retcode) {
+    pn::format(
+            out,
+            "usage: {0} [OPTIONS] EXPECTED ACTUAL\n"
+            "\n"
+            "  Compares two PNG images, channel by channel\n"
+            "\n"
+            "  options:\n"
+            "    -t, --tolerance=N   allow channels to differ by up to N (default: 0)\n"
+            "    -h, --help          display this help screen\n",
+            progname);
+    exit(retcode);
+}
+
+ArrayPixMap read(pn::string_view path) {
+    pn::file file = pn::open(path, "r");
+    if (!file) {
+        throw std::runtime_error(pn::format("{0}: couldn't open", path).c_str());
+    }
+    return read_png(file);
+}
+
+int difference(uint8_t x, uint8_t y) { return (x > y) ? (x - y) : (y - x); }
+
+void main(int argc, char* const* argv) {
+    args::callbacks callbacks;
+
+    sfz::optional<pn::string> expected_path, actual_path;
+    callbacks.argument = [&expected_path, &actual_path](pn::string_view arg) {
+        if (!expected_path.has_value()) {
+            expected_path.emplace(arg.copy());
+        } else if (!actual_path.has_value()) {
+            actual_path.emplace(arg.copy());
+        } else {
+            return false;
+        }
+        return true;
+    };
+
+    int tolerance          = 0;
+    callbacks.short_option = [&argv, &tolerance](
+                                     pn::rune opt, const args::callbacks::get_value_f& get_value) {
+        switch (opt.value()) {
+            case 't': sfz::args::integer_option(get_value(), &tolerance); return true;
+            case 'h': usage(stdout, sfz::path::basename(argv[0]), 0); return true;
+            default: return false;
+        }
+    };
+    callbacks.long_option =
+            [&callbacks](pn::string_view opt, const args::callbacks::get_value_f& get_value) {
+                if (opt == "tolerance") {
+                    return callbacks.short_option(pn::rune{'t'}, get_value);
+                } else if (opt == "help") {
+                    return callbacks.short_option(pn::rune{'h'}, get_value);
+                } else {
+                    return false;
+                }
+            };
+
+    args::parse(argc - 1, argv + 1, callbacks);
+    if (!actual_path.has_value()) {
+        throw std::runtime_error("missing required arguments 'expected' and 'actual'");
+    }
+
+    const ArrayPixMap expected = read(*expected_path);
+    const ArrayPixMap actual   = read(*actual_path);
+    if (expected.size() != actual.size()) {
+        pn::format(
+                stderr, "{0}: size {1}x{2} differs from {3}x{4}\n", *actual_path,
+                actual.size().width, actual.size().height, expected.size().width,
+                expected.size().height);
+        exit(1);
+    }
+
+    int64_t differing = 0;
+    int     worst     = 0;
+    for (int y = 0; y < expected.size().height; ++y) {
+        for (int x = 0; x < expected.size().width; ++x) {
+            const RgbColor e = expected.get(x, y);
+            const RgbColor a = actual.get(x, y);
+            const int      d = std::max(
+                    std::max(difference(e.red, a.red), difference(e.green, a.green)),
+                    std::max(difference(e.blue, a.blue), difference(e.alpha, a.alpha)));
+            if (d > tolerance) {
+                ++differing;
+            }
+            worst = std::max(worst, d);
+        }
+    }
+    if (differing) {
+        pn::format(
+                stderr, "{0}: {1} of {2} pixels differ by more than {3} (at most {4})\n",
+                *actual_path, differing, int64_t{expected.size().width} * expected.size().height,
+                tolerance, worst);
+        exit(1);
+    }
+}
+
+void print_nested_exception(const std::exception& e) {
+    pn::format(stderr, ": {0}", e.what());
+    try {
+        std::rethrow_if_nested(e);
+    } catch (const std::exception& e) {
+        print_nested_exception(e);
+    }
+}
+
+void print_exception(pn::string_view progname, const std::exception& e) {
+    pn::format(stderr, "{0}: {1}", sfz::path::basename(progname), e.what());
+    try {
+        std::rethrow_if_nested(e);
+    } catch (const std::exception& e) {
+        print_nested_exception(e);
+    }
+    pn::format(stderr, "\n");
+}
+
+}  // namespace
+}  // namespace antares
+
+int main(int argc, char* const* argv) {
+    try {
+        antares::main(argc, argv);
+    } catch (const std::exception& e) {
+        antares::print_exception(argv[0], e);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,205 @@
+// Copyright (C) 1997, 1999-2001, 2008 Nathan Lamont
+// Copyright (C) 2008-2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#include <chrono>
+#include <pn/file>
+#include <sfz/sfz.hpp>
+#include <vector>
+
+#include "data/pool.hpp"
+#include "math/random.hpp"
+
+namespace args = sfz::args;
+
+namespace antares {
+namespace {
+
+const int kSizes[] = {250, 2000, 10000};
+
+struct Slot {
+    bool     active = false;
+    PoolSlot pool_slot;
+};
+
+// The allocator that Pool replaced: a linear scan for the first inactive slot.
+class ScanAllocator {
+  public:
+    explicit ScanAllocator(int capacity) : _slots(capacity) {}
+
+    int allocate() {
+        for (int i = 0; i < _slots.size(); ++i) {
+            if (!_slots[i].active) {
+                _slots[i].active = true;
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    void release(int number) { _slots[number].active = false; }
+
+  private:
+    std::vector<Slot> _slots;
+};
+
+class PoolAllocator {
+  public:
+    explicit PoolAllocator(int capacity) { _pool.reset(capacity); }
+
+    int allocate() {
+        int number = _pool.allocate();
+        if (number >= 0) {
+            _pool.get(number)->active = true;
+        }
+        return number;
+    }
+
+    void release(int number) {
+        _pool.get(number)->active = false;
+        _pool.release(number);
+    }
+
+  private:
+    Pool<Slot> _pool;
+};
+
+// Models a spawn-heavy level: the level fills up to capacity, then each tick a burst of objects
+// (shots, explosions, debris) expires at random and is immediately replaced.  Records the slot
+// handed out for every spawn, so the allocators can be checked against each other.
+template <typename Allocator>
+int64_t run(int capacity, int ticks, int32_t seed, std::vector<int>* spawned) {
+    Allocator        allocator(capacity);
+    std::vector<int> live;
+    Random           random = {seed};
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < capacity; ++i) {
+        int number = allocator.allocate();
+        spawned->push_back(number);
+        live.push_back(number);
+    }
+    for (int tick = 0; tick < ticks; ++tick) {
+        int burst = 1 + (capacity / 8);
+        for (int i = 0; i < burst; ++i) {
+            int index = random.next(live.size());
+            allocator.release(live[index]);
+            live[index] = live.back();
+            live.pop_back();
+        }
+        for (int i = 0; i < burst; ++i) {
+            int number = allocator.allocate();
+            spawned->push_back(number);
+            live.push_back(number);
+        }
+        if (allocator.allocate() != -1) {
+            throw std::runtime_error("allocated past capacity");
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+}
+
+void usage(pn::file_view out, pn::string_view progname, int retcode) {
+    pn::format(
+            out,
+            "usage: {0} [OPTIONS]\n"
+            "\n"
+            "  Compares space object slot allocators at 250, 2000, and 10000 objects\n"
+            "\n"
+            "  options:\n"
+            "    -t, --ticks=TICKS   ticks to simulate per size (default: 1000)\n"
+            "        --help          display this help screen\n",
+            progname);
+    exit(retcode);
+}
+
+void main(int argc, char* const* argv) {
+    args::callbacks callbacks;
+
+    callbacks.argument = [](pn::string_view arg) { return false; };
+
+    int ticks              = 1000;
+    callbacks.short_option = [&ticks](
+                                     pn::rune opt, const args::callbacks::get_value_f& get_value) {
+        switch (opt.value()) {
+            case 't': sfz::args::integer_option(get_value(), &ticks); return true;
+            default: return false;
+        }
+    };
+
+    callbacks.long_option = [&argv, &callbacks](
+                                    pn::string_view                     opt,
+                                    const args::callbacks::get_value_f& get_value) {
+        if (opt == "ticks") {
+            return callbacks.short_option(pn::rune{'t'}, get_value);
+        } else if (opt == "help") {
+            usage(stdout, sfz::path::basename(argv[0]), 0);
+            return true;
+        } else {
+            return false;
+        }
+    };
+
+    args::parse(argc - 1, argv + 1, callbacks);
+
+    pn::format(stdout, "{0}\t{1}\t{2}\t{3}\n", "objects", "spawns", "scan (us)", "pool (us)");
+    for (int capacity : kSizes) {
+        std::vector<int> scan_spawned, pool_spawned;
+        int64_t          scan_us = run<ScanAllocator>(capacity, ticks, capacity, &scan_spawned);
+        int64_t          pool_us = run<PoolAllocator>(capacity, ticks, capacity, &pool_spawned);
+        if (scan_spawned != pool_spawned) {
+            throw std::runtime_error(
+                    pn::format("slot order differs at {0} objects", capacity).c_str());
+        }
+        pn::format(
+                stdout, "{0}\t{1}\t{2}\t{3}\n", capacity, pool_spawned.size(), scan_us,
+                pool_us);
+    }
+}
+
+void print_nested_exception(const std::exception& e) {
+    pn::format(stderr, ": {0}", e.what());
+    try {
+        std::rethrow_if_nested(e);
+    } catch (const std::exception& e) {
+        print_nested_exception(e);
+    }
+}
+
+void print_exception(pn::string_view progname, const std::exception& e) {
+    pn::format(stderr, "{0}: {1}", sfz::path::basename(progname), e.what());
+    try {
+        std::rethrow_if_nested(e);
+    } catch (const std::exception& e) {
+        print_nested_exception(e);
+    }
+    pn::format(stderr, "\n");
+}
+
+}  // namespace
+}  // namespace antares
+
+int main(int argc, char* const* argv) {
+    try {
+        antares::main(argc, argv);
+    } catch (const std::exception& e) {
+        antares::print_exception(argv[0], e);
+        return 1;
+    }
+    return 0;
+}
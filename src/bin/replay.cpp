@@ -18,8 +18,10 @@
 
 #include <fcntl.h>
 #include <getopt.h>
+#include <map>
 #include <pn/file>
 #include <sfz/sfz.hpp>
+#include <vector>
 
 #include "config/ledger.hpp"
 #include "config/preferences.hpp"
@@ -29,6 +31,7 @@
 #include "drawing/color.hpp"
 #include "drawing/pix-map.hpp"
 #include "game/admiral.hpp"
+#include "game/checkpoint.hpp"
 #include "game/cheat.hpp"
 #include "game/cursor.hpp"
 #include "game/globals.hpp"
@@ -40,6 +43,7 @@
 #include "game/messages.hpp"
 #include "game/motion.hpp"
 #include "game/space-object.hpp"
+#include "game/sync-trace.hpp"
 #include "game/sys.hpp"
 #include "game/vector.hpp"
 #include "math/random.hpp"
@@ -50,7 +54,9 @@
 #include "ui/interface-handling.hpp"
 #include "ui/screens/debriefing.hpp"
 #include "video/driver.hpp"
+#include "video/frame-stream.hpp"
 #include "video/offscreen-driver.hpp"
+#include "video/software-driver.hpp"
 #include "video/text-driver.hpp"
 
 using std::unique_ptr;
@@ -84,7 +90,7 @@ class ReplayMaster : public Card {
                 g.random.seed = _random_seed;
                 stack()->push(new MainPlay(
                         Handle<Level>(_replay_data.chapter_id - 1), true, &_input_source, false,
-                        &_game_result));
+                        false, &_game_result));
                 break;
 
             case REPLAY:
@@ -136,14 +142,81 @@ void ReplayMaster::init() {
     Label::init();
     Messages::init();
     InstrumentInit();
-    SpriteHandlingInit();
+    SpriteHandlingInit(kMaxSprite);
     PluginInit();
-    SpaceObjectHandlingInit();  // MUST be after PluginInit()
+    SpaceObjectHandlingInit(kMaxSpaceObject);  // MUST be after PluginInit()
     InitMotion();
     Admiral::init();
     Vectors::init();
 }
 
+// Takes checkpoints as the replay plays, and visits each tick in `seeks` in turn, printing the
+// state there.  Seeking back, or forward past a later checkpoint, restores the nearest checkpoint
+// instead of playing from the start.  Visiting a tick again must find the same state.
+class ReplaySeeker : public CheckpointLog {
+  public:
+    ReplaySeeker(ticks interval, std::vector<game_ticks> seeks)
+            : CheckpointLog(interval), _seeks(std::move(seeks)) {}
+
+    virtual void tick(PlayerShip* player_ship) {
+        CheckpointLog::tick(player_ship);
+        while (_next < _seeks.size()) {
+            const game_ticks at = _seeks[_next];
+            if (g.time == at) {
+                visit();
+                ++_next;
+            } else if ((at < g.time) || (latest(at) > g.time)) {
+                if (!restore(at, player_ship)) {
+                    throw std::runtime_error(
+                            pn::format("no checkpoint before tick {0}", count(at)).c_str());
+                }
+            } else {
+                break;
+            }
+        }
+    }
+
+    // Throws if the replay ended before reaching every tick.
+    void check_done() const {
+        if (_next < _seeks.size()) {
+            throw std::runtime_error(
+                    pn::format("replay ended before tick {0}", count(_seeks[_next])).c_str());
+        }
+    }
+
+  private:
+    static int64_t count(game_ticks at) { return at.time_since_epoch().count(); }
+
+    void visit() {
+        const SyncRecord record = SyncRecord::current();
+        SyncHash         state;
+        for (uint32_t hash : record.hashes) {
+            state.add(hash);
+        }
+        pn::format(
+                stdout, "tick {0}: sync {1} state {2}\n", record.tick, sfz::hex(g.sync, 8),
+                sfz::hex(state.value(), 8));
+
+        auto it = _visited.find(record.tick);
+        if (it == _visited.end()) {
+            _visited.emplace(record.tick, record);
+            return;
+        }
+        for (int i = 0; i < SyncRecord::FIELD_COUNT; ++i) {
+            if (it->second.hashes[i] != record.hashes[i]) {
+                pn::string message = pn::format(
+                        "tick {0}: {1} differs after seeking back", record.tick,
+                        SyncRecord::field_name(i));
+                throw std::runtime_error(message.c_str());
+            }
+        }
+    }
+
+    const std::vector<game_ticks> _seeks;
+    size_t                        _next = 0;
+    std::map<int64_t, SyncRecord> _visited;
+};
+
 void usage(pn::file_view out, pn::string_view progname, int retcode) {
     pn::format(
             out,
@@ -162,6 +235,20 @@ void usage(pn::file_view out, pn::string_view progname, int retcode) {
             "    -h, --height=HEIGHT screen height (default: 480)\n"
             "    -t, --text          produce text output\n"
             "    -s, --smoke         run as smoke text\n"
+            "        --software      render on the CPU, without OpenGL\n"
+            "        --stream=FILE   write uncompressed video to FILE (- for stdout) instead of\n"
+            "                        PNGs in the output directory\n"
+            "        --stream-format=FORMAT\n"
+            "                        y4m or rgb (rgb24, with no header) (default: y4m)\n"
+            "        --trace=TRACE   write a per-tick sync trace to this file\n"
+            "        --verify=TRACE  check the replay against a sync trace\n"
+            "        --seek=TICK     print the state at this tick; may be repeated, in any order\n"
+            "        --checkpoint-interval=TICKS\n"
+            "                        when seeking, save the state this often (default: 3600)\n"
+            "        --atlas-stats   print how full the sprite and font atlas pages are\n"
+            "        --resource-stats\n"
+            "                        print how resource lookups were answered\n"
+            "        --frame-stats   print draw calls and drawing time per frame\n"
             "        --help          display this help screen\n",
             progname);
     exit(retcode);
@@ -199,7 +286,18 @@ void main(int argc, char* const* argv) {
         }
     };
 
-    callbacks.long_option = [&argv, &callbacks](
+    sfz::optional<pn::string> trace_path, verify_path;
+    std::vector<game_ticks>   seeks;
+    int                       checkpoint_interval = 3600;
+    bool                      atlas_stats         = false;
+    bool                      resource_stats      = false;
+    bool                      frame_stats         = false;
+    bool                      software            = false;
+    sfz::optional<pn::string> stream_path;
+    FrameStream::Format       stream_format = FrameStream::Y4M;
+    callbacks.long_option = [&argv, &callbacks, &trace_path, &verify_path, &seeks,
+                             &checkpoint_interval, &atlas_stats, &resource_stats, &frame_stats,
+                             &software, &stream_path, &stream_format](
                                     pn::string_view                     opt,
                                     const args::callbacks::get_value_f& get_value) {
         if (opt == "output") {
@@ -214,6 +312,40 @@ void main(int argc, char* const* argv) {
             return callbacks.short_option(pn::rune{'t'}, get_value);
         } else if (opt == "smoke") {
             return callbacks.short_option(pn::rune{'s'}, get_value);
+        } else if (opt == "software") {
+            software = true;
+            return true;
+        } else if (opt == "stream") {
+            stream_path.emplace(get_value().copy());
+            return true;
+        } else if (opt == "stream-format") {
+            stream_format = FrameStream::format(get_value());
+            return true;
+        } else if (opt == "trace") {
+            trace_path.emplace(get_value().copy());
+            return true;
+        } else if (opt == "verify") {
+            verify_path.emplace(get_value().copy());
+            return true;
+        } else if (opt == "seek") {
+            // The game only stops between major ticks, so round up to the next one.
+            int tick;
+            sfz::args::integer_option(get_value(), &tick);
+            const int major = kMajorTick.count();
+            seeks.push_back(game_ticks(ticks(((tick + major - 1) / major) * major)));
+            return true;
+        } else if (opt == "checkpoint-interval") {
+            sfz::args::integer_option(get_value(), &checkpoint_interval);
+            return true;
+        } else if (opt == "atlas-stats") {
+            atlas_stats = true;
+            return true;
+        } else if (opt == "resource-stats") {
+            resource_stats = true;
+            return true;
+        } else if (opt == "frame-stats") {
+            frame_stats = true;
+            return true;
         } else if (opt == "help") {
             usage(stdout, sfz::path::basename(argv[0]), 0);
             return true;
@@ -227,6 +359,33 @@ void main(int argc, char* const* argv) {
         throw std::runtime_error("missing required argument 'replay'");
     }
 
+    if (trace_path.has_value() && verify_path.has_value()) {
+        throw std::runtime_error("--trace can't be combined with --verify");
+    }
+
+    if (!seeks.empty() && (trace_path.has_value() || verify_path.has_value())) {
+        throw std::runtime_error("--seek can't be combined with --trace or --verify");
+    }
+
+    // Only the OpenGL driver counts frames and fills atlases.
+    if ((atlas_stats || frame_stats) && (software || text || smoke)) {
+        throw std::runtime_error(
+                "--atlas-stats and --frame-stats can't be combined with --software, --text, or "
+                "--smoke");
+    }
+
+    if (stream_path.has_value()) {
+        if (text || smoke) {
+            throw std::runtime_error("--stream can't be combined with --text or --smoke");
+        } else if ((*stream_path == "-") &&
+                   (atlas_stats || resource_stats || frame_stats || !seeks.empty() ||
+                    verify_path.has_value())) {
+            throw std::runtime_error(
+                    "--stream=- can't be combined with --atlas-stats, --resource-stats, "
+                    "--frame-stats, --seek, or --verify");
+        }
+    }
+
     if (output_dir.has_value()) {
         sfz::makedirs(*output_dir, 0755);
     }
@@ -251,6 +410,38 @@ void main(int argc, char* const* argv) {
     }
     NullLedger ledger;
 
+    unique_ptr<SyncTraceWriter>   trace;
+    unique_ptr<SyncTraceVerifier> verifier;
+    if (trace_path.has_value()) {
+        trace.reset(new SyncTraceWriter(*trace_path));
+        set_sync_trace(trace.get());
+    } else if (verify_path.has_value()) {
+        verifier.reset(new SyncTraceVerifier(*verify_path));
+        set_sync_trace(verifier.get());
+    }
+
+    unique_ptr<ReplaySeeker> seeker;
+    if (!seeks.empty()) {
+        seeker.reset(new ReplaySeeker(ticks(checkpoint_interval), std::move(seeks)));
+        set_checkpoint_log(seeker.get());
+    }
+
+    pn::file                stream_file;
+    unique_ptr<FrameStream> stream;
+    if (stream_path.has_value()) {
+        if (*stream_path == "-") {
+            stream.reset(new FrameStream(stdout, stream_format, {width, height}, interval));
+        } else {
+            stream_file = pn::open(*stream_path, "w");
+            if (!stream_file) {
+                throw std::runtime_error(
+                        pn::format("{0}: couldn't open stream", *stream_path).c_str());
+            }
+            stream.reset(
+                    new FrameStream(stream_file, stream_format, {width, height}, interval));
+        }
+    }
+
     sfz::mapped_file replay_file(*replay_path);
     if (smoke) {
         TextVideoDriver video({width, height}, sfz::optional<pn::string>());
@@ -258,9 +449,35 @@ void main(int argc, char* const* argv) {
     } else if (text) {
         TextVideoDriver video({width, height}, output_dir);
         video.loop(new ReplayMaster(replay_file.data(), output_dir), scheduler);
+    } else if (software) {
+        SoftwareVideoDriver video({width, height}, output_dir);
+        video.set_stream(stream.get());
+        video.loop(new ReplayMaster(replay_file.data(), output_dir), scheduler);
     } else {
         OffscreenVideoDriver video({width, height}, output_dir);
+        video.set_stream(stream.get());
         video.loop(new ReplayMaster(replay_file.data(), output_dir), scheduler);
+        if (atlas_stats) {
+            pn::format(stdout, "{0}", video.atlas_stats());
+        }
+        if (frame_stats) {
+            pn::format(stdout, "{0}", video.frame_stats());
+        }
+    }
+    set_sync_trace(nullptr);
+    set_checkpoint_log(nullptr);
+    if (resource_stats) {
+        pn::format(stdout, "{0}", Resource::stats());
+    }
+
+    if (seeker) {
+        seeker->check_done();
+    }
+    if (verifier) {
+        if (!verifier->in_sync()) {
+            throw std::runtime_error(verifier->report().c_str());
+        }
+        pn::format(stdout, "{0}\n", verifier->report());
     }
 }
 
@@ -0,0 +1,313 @@
+// Copyright (C) 1997, 1999-2001, 2008 Nathan Lamont
+// Copyright (C) 2008-2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#include <algorithm>
+#include <chrono>
+#include <pn/file>
+#include <sfz/sfz.hpp>
+
+#include "config/ledger.hpp"
+#include "config/preferences.hpp"
+#include "data/plugin.hpp"
+#include "data/replay.hpp"
+#include "drawing/sprite-handling.hpp"
+#include "game/admiral.hpp"
+#include "game/globals.hpp"
+#include "game/input-source.hpp"
+#include "game/instruments.hpp"
+#include "game/labels.hpp"
+#include "game/main.hpp"
+#include "game/messages.hpp"
+#include "game/motion.hpp"
+#include "game/space-object.hpp"
+#include "game/sync-trace.hpp"
+#include "game/sys.hpp"
+#include "game/vector.hpp"
+#include "game/workers.hpp"
+#include "math/random.hpp"
+#include "sound/driver.hpp"
+#include "ui/card.hpp"
+#include "video/text-driver.hpp"
+
+using sfz::hex;
+using std::unique_ptr;
+
+namespace args = sfz::args;
+
+namespace antares {
+namespace {
+
+struct SimResult {
+    int32_t    chapter;
+    GameResult game_result;
+    usecs      elapsed;
+};
+
+// Runs a replay through the simulation alone. The TextVideoDriver never
+// takes a snapshot, so nothing is drawn, and the game runs headless, so
+// per-tick display updates are skipped too.
+class SimMaster : public Card {
+  public:
+    SimMaster(pn::data_view data, int32_t max_objects, SimResult* result)
+            : _state(NEW),
+              _replay_data(data),
+              _random_seed(_replay_data.global_seed),
+              _game_result(NO_GAME),
+              _input_source(&_replay_data),
+              _max_objects(max_objects),
+              _result(result) {}
+
+    virtual void become_front() {
+        switch (_state) {
+            case NEW:
+                _state = SIMULATE;
+                init();
+                Randomize(4);  // For the decision to replay intro.
+                _game_result  = NO_GAME;
+                g.random.seed = _random_seed;
+                _start        = std::chrono::steady_clock::now();
+                stack()->push(new MainPlay(
+                        Handle<Level>(_replay_data.chapter_id - 1), true, &_input_source, false,
+                        true, &_game_result));
+                break;
+
+            case SIMULATE:
+                _result->chapter     = _replay_data.chapter_id;
+                _result->game_result = _game_result;
+                _result->elapsed     = std::chrono::duration_cast<usecs>(
+                        std::chrono::steady_clock::now() - _start);
+                stack()->pop(this);
+                break;
+        }
+    }
+
+  private:
+    void init();
+
+    enum State {
+        NEW,
+        SIMULATE,
+    };
+    State _state;
+
+    ReplayData        _replay_data;
+    const int32_t     _random_seed;
+    GameResult        _game_result;
+    ReplayInputSource _input_source;
+    const int32_t     _max_objects;
+    SimResult* const  _result;
+
+    std::chrono::steady_clock::time_point _start;
+};
+
+void SimMaster::init() {
+    init_globals();
+    sys_init();
+    Label::init();
+    Messages::init();
+    InstrumentInit();
+    SpriteHandlingInit(_max_objects * (kMaxSprite / kMaxSpaceObject));
+    PluginInit();
+    SpaceObjectHandlingInit(_max_objects);  // MUST be after PluginInit()
+    InitMotion();
+    Admiral::init();
+    Vectors::init();
+}
+
+pn::string_view result_name(GameResult result) {
+    switch (result) {
+        case NO_GAME: return "none";
+        case LOSE_GAME: return "lose";
+        case WIN_GAME: return "win";
+        case RESTART_GAME: return "restart";
+        case QUIT_GAME: return "quit";
+    }
+    return "unknown";
+}
+
+void print_summary(const SimResult& result) {
+    Handle<Admiral> player(0);
+    const int64_t   ticks = g.time.time_since_epoch().count();
+    const int64_t   us    = std::max<int64_t>(1, result.elapsed.count());
+    pn::format(stdout, "chapter: {0}\n", result.chapter);
+    pn::format(stdout, "result: {0}\n", result_name(result.game_result));
+    pn::format(stdout, "victor: {0}\n", g.victor.number());
+    pn::format(stdout, "next level: {0}\n", g.next_level);
+    pn::format(stdout, "kills: {0}\n", GetAdmiralKill(player));
+    pn::format(stdout, "losses: {0}\n", GetAdmiralLoss(player));
+    pn::format(stdout, "sync: {0}\n", hex(g.sync, 8));
+    pn::format(stdout, "object slots: {0}/{1}\n", g.objects.size(), g.objects.capacity());
+    pn::format(stdout, "ticks: {0}\n", ticks);
+    pn::format(stdout, "threads: {0}\n", worker_threads());
+    pn::format(stdout, "elapsed: {0}us\n", us);
+    pn::format(stdout, "ticks/sec: {0}\n", (ticks * 1000000) / us);
+}
+
+void usage(pn::file_view out, pn::string_view progname, int retcode) {
+    pn::format(
+            out,
+            "usage: {0} [OPTIONS] replay\n"
+            "\n"
+            "  Simulates a replay without rendering and reports the outcome\n"
+            "\n"
+            "  arguments:\n"
+            "    replay              an Antares replay script\n"
+            "\n"
+            "  options:\n"
+            "    -w, --width=WIDTH   screen width (default: 640)\n"
+            "    -h, --height=HEIGHT screen height (default: 480)\n"
+            "    -m, --max-objects=N maximum space objects (default: 250)\n"
+            "    -t, --threads=N     simulation threads (default: 1)\n"
+            "        --trace=TRACE   write a per-tick sync trace to this file\n"
+            "        --verify=TRACE  check the replay against a sync trace\n"
+            "        --help          display this help screen\n",
+            progname);
+    exit(retcode);
+}
+
+void main(int argc, char* const* argv) {
+    args::callbacks callbacks;
+
+    sfz::optional<pn::string> replay_path;
+    callbacks.argument = [&replay_path](pn::string_view arg) {
+        if (!replay_path.has_value()) {
+            replay_path.emplace(arg.copy());
+        } else {
+            return false;
+        }
+        return true;
+    };
+
+    int     width          = 640;
+    int     height         = 480;
+    int32_t max_objects    = kMaxSpaceObject;
+    int     threads        = 1;
+    callbacks.short_option = [&width, &height, &max_objects, &threads](
+                                     pn::rune opt, const args::callbacks::get_value_f& get_value) {
+        switch (opt.value()) {
+            case 'w': sfz::args::integer_option(get_value(), &width); return true;
+            case 'h': sfz::args::integer_option(get_value(), &height); return true;
+            case 'm': sfz::args::integer_option(get_value(), &max_objects); return true;
+            case 't': sfz::args::integer_option(get_value(), &threads); return true;
+            default: return false;
+        }
+    };
+
+    sfz::optional<pn::string> trace_path, verify_path;
+    callbacks.long_option = [&argv, &callbacks, &trace_path, &verify_path](
+                                    pn::string_view                     opt,
+                                    const args::callbacks::get_value_f& get_value) {
+        if (opt == "width") {
+            return callbacks.short_option(pn::rune{'w'}, get_value);
+        } else if (opt == "height") {
+            return callbacks.short_option(pn::rune{'h'}, get_value);
+        } else if (opt == "max-objects") {
+            return callbacks.short_option(pn::rune{'m'}, get_value);
+        } else if (opt == "threads") {
+            return callbacks.short_option(pn::rune{'t'}, get_value);
+        } else if (opt == "trace") {
+            trace_path.emplace(get_value().copy());
+            return true;
+        } else if (opt == "verify") {
+            verify_path.emplace(get_value().copy());
+            return true;
+        } else if (opt == "help") {
+            usage(stdout, sfz::path::basename(argv[0]), 0);
+            return true;
+        } else {
+            return false;
+        }
+    };
+
+    args::parse(argc - 1, argv + 1, callbacks);
+    if (!replay_path.has_value()) {
+        throw std::runtime_error("missing required argument 'replay'");
+    }
+
+    if (trace_path.has_value() && verify_path.has_value()) {
+        throw std::runtime_error("--trace can't be combined with --verify");
+    }
+
+    set_worker_threads(threads);
+
+    Preferences preferences;
+    preferences.play_music_in_game = true;
+    NullPrefsDriver prefs(preferences.copy());
+
+    EventScheduler scheduler;
+    scheduler.schedule_event(unique_ptr<Event>(new MouseMoveEvent(wall_time(), Point(320, 240))));
+
+    NullSoundDriver sound;
+    NullLedger      ledger;
+
+    unique_ptr<SyncTraceWriter>   trace;
+    unique_ptr<SyncTraceVerifier> verifier;
+    if (trace_path.has_value()) {
+        trace.reset(new SyncTraceWriter(*trace_path));
+        set_sync_trace(trace.get());
+    } else if (verify_path.has_value()) {
+        verifier.reset(new SyncTraceVerifier(*verify_path));
+        set_sync_trace(verifier.get());
+    }
+
+    sfz::mapped_file replay_file(*replay_path);
+    SimResult        result = {0, NO_GAME, usecs(0)};
+    TextVideoDriver  video({width, height}, sfz::optional<pn::string>());
+    video.loop(new SimMaster(replay_file.data(), max_objects, &result), scheduler);
+    set_sync_trace(nullptr);
+    print_summary(result);
+
+    if (verifier) {
+        if (!verifier->in_sync()) {
+            throw std::runtime_error(verifier->report().c_str());
+        }
+        pn::format(stdout, "trace: {0}\n", verifier->report());
+    }
+}
+
+void print_nested_exception(const std::exception& e) {
+    pn::format(stderr, ": {0}", e.what());
+    try {
+        std::rethrow_if_nested(e);
+    } catch (const std::exception& e) {
+        print_nested_exception(e);
+    }
+}
+
+void print_exception(pn::string_view progname, const std::exception& e) {
+    pn::format(stderr, "{0}: {1}", sfz::path::basename(progname), e.what());
+    try {
+        std::rethrow_if_nested(e);
+    } catch (const std::exception& e) {
+        print_nested_exception(e);
+    }
+    pn::format(stderr, "\n");
+}
+
+}  // namespace
+}  // namespace antares
+
+int main(int argc, char* const* argv) {
+    try {
+        antares::main(argc, argv);
+    } catch (const std::exception& e) {
+        antares::print_exception(argv[0], e);
+        return 1;
+    }
+    return 0;
+}
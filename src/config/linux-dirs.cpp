@@ -57,6 +57,8 @@ Directories linux_dirs() {
     directories.replays += "/replays";
     directories.scenarios = directories.root.copy();
     directories.scenarios += "/scenarios";
+    directories.cache = directories.root.copy();
+    directories.cache += "/cache";
     return directories;
 };
 
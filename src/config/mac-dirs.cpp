@@ -62,6 +62,7 @@ Directories mac_dirs() {
     directories.registry  = pn::format("{0}/Registry", directories.root);
     directories.replays   = pn::format("{0}/Replays", directories.root);
     directories.scenarios = pn::format("{0}/Scenarios", directories.root);
+    directories.cache     = pn::format("{0}/Caches", directories.root);
     return directories;
 };
 
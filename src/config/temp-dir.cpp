@@ -0,0 +1,44 @@
+// Copyright (C) 1997, 1999-2001, 2008 Nathan Lamont
+// Copyright (C) 2013-2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#include "config/temp-dir.hpp"
+
+#include <stdlib.h>
+#include <sfz/sfz.hpp>
+#include <stdexcept>
+#include <vector>
+
+namespace antares {
+
+TempDir::TempDir(pn::string_view prefix) {
+    pn::string        templ = pn::format("/tmp/{0}-XXXXXX", prefix);
+    std::vector<char> buf(templ.c_str(), templ.c_str() + templ.size() + 1);
+    if (!mkdtemp(buf.data())) {
+        throw std::runtime_error(pn::format("{0}: couldn't create directory", templ).c_str());
+    }
+    _path = pn::string_view{buf.data()}.copy();
+}
+
+TempDir::~TempDir() {
+    try {
+        sfz::rmtree(_path);
+    } catch (...) {
+    }
+}
+
+}  // namespace antares
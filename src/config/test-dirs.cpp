@@ -18,6 +18,7 @@
 
 #include "config/dirs.hpp"
 
+#include <stdlib.h>
 #include <sys/param.h>
 #include <unistd.h>
 #include <pn/file>
@@ -42,6 +43,12 @@ Directories test_dirs() {
     directories.registry  = pn::format("{0}/registry", directories.root);
     directories.replays   = pn::format("{0}/replays", directories.root);
     directories.scenarios = pn::format("{0}/scenarios", directories.root);
+    // No cache, so that tests always exercise the uncached paths, and don't write to the
+    // application data.  Tests of the cache itself set $ANTARES_TEST_CACHE to a directory of
+    // their own.
+    if (const char* cache = getenv("ANTARES_TEST_CACHE")) {
+        directories.cache = cache;
+    }
     return directories;
 };
 
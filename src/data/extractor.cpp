@@ -31,6 +31,7 @@
 
 #include "config/dirs.hpp"
 #include "data/replay.hpp"
+#include "data/resource-pack.hpp"
 #include "drawing/pix-map.hpp"
 #include "math/geometry.hpp"
 #include "net/http.hpp"
@@ -429,7 +430,7 @@ static const ResourceFile::ExtractedResource kPluginFiles[] = {
 };
 
 static const char kDownloadBase[] = "http://downloads.arescentral.org";
-static const char kVersion[]      = "16\n";
+static const char kVersion[]      = "17\n";
 
 static const char kPluginVersionFile[]    = "data/version";
 static const char kPluginVersion[]        = "1\n";
@@ -525,6 +526,7 @@ void DataExtractor::extract_factory_scenario(Observer* observer) const {
         pn::string scenario_dir = pn::format("{0}/{1}", _output_dir, kFactoryScenarioIdentifier);
         rmtree(scenario_dir);
         extract_original(observer, "Ares-1.2.0.zip");
+        pack(observer, kFactoryScenarioIdentifier);
         write_version(kFactoryScenarioIdentifier);
     }
 }
@@ -534,6 +536,7 @@ void DataExtractor::extract_plugin_scenario(Observer* observer) const {
         pn::string scenario_dir = pn::format("{0}/{1}", _output_dir, _scenario);
         rmtree(scenario_dir);
         extract_plugin(observer);
+        pack(observer, _scenario);
         write_version(_scenario);
     }
 }
@@ -595,6 +598,12 @@ void DataExtractor::download(
     file.write(download);
 }
 
+void DataExtractor::pack(Observer* observer, pn::string_view scenario_identifier) const {
+    pn::string status = pn::format("Packing {0}...", scenario_identifier);
+    observer->status(status);
+    ResourcePack::write(pn::format("{0}/{1}", _output_dir, scenario_identifier));
+}
+
 void DataExtractor::write_version(pn::string_view scenario_identifier) const {
     pn::string path = pn::format("{0}/{1}/version", _output_dir, scenario_identifier);
     makedirs(path::dirname(path), 0755);
@@ -0,0 +1,229 @@
+// Copyright (C) 1997, 1999-2001, 2008 Nathan Lamont
+// Copyright (C) 2008-2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#include "data/resource-pack.hpp"
+
+#include <dirent.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <algorithm>
+#include <pn/file>
+#include <string>
+#include <vector>
+
+using std::unique_ptr;
+
+namespace path = sfz::path;
+
+namespace antares {
+
+namespace {
+
+const char    kMagic[]     = "antpack1";
+const int64_t kHeaderSize  = 12;
+const int     kEntryFields = 5;
+
+enum { HASH, PATH_OFFSET, PATH_SIZE, DATA_OFFSET, DATA_SIZE };
+
+// FNV-1a.
+uint32_t path_hash(pn::string_view path) {
+    uint32_t hash = 2166136261u;
+    for (int i = 0; i < path.size(); ++i) {
+        hash = (hash ^ uint8_t(path.data()[i])) * 16777619u;
+    }
+    return hash;
+}
+
+void put_u32(uint8_t* out, uint32_t value) {
+    out[0] = value >> 24;
+    out[1] = value >> 16;
+    out[2] = value >> 8;
+    out[3] = value;
+}
+
+uint32_t get_u32(const uint8_t* in) {
+    return (uint32_t(in[0]) << 24) | (uint32_t(in[1]) << 16) | (uint32_t(in[2]) << 8) |
+           uint32_t(in[3]);
+}
+
+struct PackedFile {
+    uint32_t    hash;
+    std::string path;
+    int64_t     size;
+};
+
+// Appends the regular files under `dir`/`prefix` to `files`, with paths relative to `dir`.
+void list_files(pn::string_view dir, const std::string& prefix, std::vector<PackedFile>* files) {
+    pn::string full = prefix.empty() ? dir.copy() : pn::format("{0}/{1}", dir, prefix.c_str());
+    DIR*       d    = opendir(full.c_str());
+    if (!d) {
+        throw std::runtime_error(pn::format("{0}: couldn't list directory", full).c_str());
+    }
+    while (struct dirent* e = readdir(d)) {
+        if (e->d_name[0] == '.') {
+            continue;
+        }
+        std::string name = prefix.empty() ? e->d_name : (prefix + "/" + e->d_name);
+        pn::string  path = pn::format("{0}/{1}", dir, name.c_str());
+        struct stat st;
+        if (stat(path.c_str(), &st) < 0) {
+            continue;
+        } else if (S_ISDIR(st.st_mode)) {
+            list_files(dir, name, files);
+        } else if (S_ISREG(st.st_mode) && (name != ResourcePack::kFileName)) {
+            files->push_back(PackedFile{
+                    path_hash(pn::string_view{name.data(), int(name.size())}), name,
+                    st.st_size});
+        }
+    }
+    closedir(d);
+}
+
+}  // namespace
+
+const char ResourcePack::kFileName[] = "resources.pack";
+
+void ResourcePack::write(pn::string_view dir) {
+    std::vector<PackedFile> files;
+    list_files(dir, "", &files);
+    std::sort(files.begin(), files.end(), [](const PackedFile& x, const PackedFile& y) {
+        return (x.hash != y.hash) ? (x.hash < y.hash) : (x.path < y.path);
+    });
+
+    std::vector<uint8_t> table(kHeaderSize + (files.size() * kEntryFields * 4));
+    memcpy(table.data(), kMagic, 8);
+    put_u32(&table[8], files.size());
+    int64_t offset = table.size();
+    for (const PackedFile& f : files) {
+        offset += f.path.size() + f.size;
+    }
+    if (offset > UINT32_MAX) {
+        throw std::runtime_error(pn::format("{0}: too large to pack", dir).c_str());
+    }
+
+    offset = table.size();
+    for (int i = 0; i < files.size(); ++i) {
+        uint8_t* e = &table[kHeaderSize + (i * kEntryFields * 4)];
+        put_u32(e + (4 * HASH), files[i].hash);
+        put_u32(e + (4 * PATH_OFFSET), offset);
+        put_u32(e + (4 * PATH_SIZE), files[i].path.size());
+        offset += files[i].path.size();
+    }
+    for (int i = 0; i < files.size(); ++i) {
+        uint8_t* e = &table[kHeaderSize + (i * kEntryFields * 4)];
+        put_u32(e + (4 * DATA_OFFSET), offset);
+        put_u32(e + (4 * DATA_SIZE), files[i].size);
+        offset += files[i].size;
+    }
+
+    // Write to a hidden temporary file, and rename it into place once it's complete, so that a
+    // pack is never seen half-written, and a failed one is never packed.
+    pn::string tmp_path = pn::format("{0}/.{1}.tmp", dir, kFileName);
+    {
+        pn::file out = pn::open(tmp_path, "w");
+        out.write(pn::data_view{table.data(), int(table.size())});
+        for (const PackedFile& f : files) {
+            out.write(pn::string_view{f.path.data(), int(f.path.size())});
+        }
+        for (const PackedFile& f : files) {
+            if (f.size == 0) {
+                continue;  // nothing to map.
+            }
+            pn::string       path = pn::format("{0}/{1}", dir, f.path.c_str());
+            sfz::mapped_file file(path);
+            if (file.data().size() != f.size) {
+                throw std::runtime_error(pn::format("{0}: changed while packing", path).c_str());
+            }
+            out.write(file.data());
+        }
+        if (out.error()) {
+            throw std::runtime_error(pn::format("{0}: couldn't write", tmp_path).c_str());
+        }
+    }
+    pn::string pack_path = pn::format("{0}/{1}", dir, kFileName);
+    if (rename(tmp_path.c_str(), pack_path.c_str()) < 0) {
+        throw std::runtime_error(pn::format("{0}: couldn't write", pack_path).c_str());
+    }
+}
+
+std::vector<std::string> ResourcePack::files(pn::string_view dir) {
+    std::vector<PackedFile> files;
+    list_files(dir, "", &files);
+    std::vector<std::string> paths;
+    for (PackedFile& f : files) {
+        paths.push_back(std::move(f.path));
+    }
+    return paths;
+}
+
+unique_ptr<ResourcePack> ResourcePack::open(pn::string_view dir) {
+    pn::string pack_path = pn::format("{0}/{1}", dir, kFileName);
+    if (!path::isfile(pack_path)) {
+        return nullptr;
+    }
+    return unique_ptr<ResourcePack>(new ResourcePack(pack_path));
+}
+
+ResourcePack::ResourcePack(pn::string_view path) : _file(path) {
+    const pn::data_view data = _file.data();
+    if ((data.size() < kHeaderSize) || (memcmp(data.data(), kMagic, 8) != 0)) {
+        throw std::runtime_error(pn::format("{0}: not a resource pack", path).c_str());
+    }
+    _count = get_u32(data.data() + 8);
+    if ((kHeaderSize + (int64_t(_count) * kEntryFields * 4)) > data.size()) {
+        throw std::runtime_error(pn::format("{0}: truncated resource pack", path).c_str());
+    }
+    for (uint32_t i = 0; i < _count; ++i) {
+        if (((int64_t(entry(i, PATH_OFFSET)) + entry(i, PATH_SIZE)) > data.size()) ||
+            ((int64_t(entry(i, DATA_OFFSET)) + entry(i, DATA_SIZE)) > data.size())) {
+            throw std::runtime_error(pn::format("{0}: truncated resource pack", path).c_str());
+        }
+    }
+}
+
+uint32_t ResourcePack::entry(uint32_t index, int field) const {
+    return get_u32(_file.data().data() + kHeaderSize + (((index * kEntryFields) + field) * 4));
+}
+
+bool ResourcePack::find(pn::string_view path, pn::data_view* data) const {
+    const uint32_t hash = path_hash(path);
+    uint32_t       lo = 0, hi = _count;
+    while (lo < hi) {
+        uint32_t mid = lo + ((hi - lo) / 2);
+        if (entry(mid, HASH) < hash) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+
+    const uint8_t* base = _file.data().data();
+    for (uint32_t i = lo; (i < _count) && (entry(i, HASH) == hash); ++i) {
+        const pn::string_view candidate{
+                reinterpret_cast<const char*>(base + entry(i, PATH_OFFSET)),
+                int(entry(i, PATH_SIZE))};
+        if (candidate == path) {
+            *data = pn::data_view{base + entry(i, DATA_OFFSET), int(entry(i, DATA_SIZE))};
+            return true;
+        }
+    }
+    return false;
+}
+
+}  // namespace antares
@@ -0,0 +1,236 @@
+// Copyright (C) 1997, 1999-2001, 2008 Nathan Lamont
+// Copyright (C) 2008-2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#include "data/resource-pack.hpp"
+
+#include <gmock/gmock.h>
+#include <map>
+#include <pn/file>
+#include <string>
+#include <vector>
+
+#include "config/dirs.hpp"
+#include "config/preferences.hpp"
+#include "config/temp-dir.hpp"
+#include "data/resource.hpp"
+
+using std::map;
+using std::string;
+using std::vector;
+
+namespace antares {
+namespace {
+
+class ResourcePackTest : public testing::Test {
+  public:
+    ResourcePackTest() : _dir("resource-pack-test") {}
+
+    pn::string_view dir() const { return _dir.path(); }
+
+    // Writes `contents` to `path`, relative to dir(), creating its parent directories.
+    void put(const string& path, const string& contents) {
+        sfz::makedirs(sfz::path::dirname(pn::format("{0}/{1}", dir(), path.c_str())), 0755);
+        pn::file f = pn::open(pn::format("{0}/{1}", dir(), path.c_str()), "w");
+        f.write(pn::data_view{reinterpret_cast<const uint8_t*>(contents.data()),
+                              int(contents.size())});
+        _files[path] = contents;
+    }
+
+    // The files put() so far, by path.
+    const map<string, string>& files() const { return _files; }
+
+    pn::string pack_path() const {
+        return pn::format("{0}/{1}", dir(), ResourcePack::kFileName);
+    }
+
+    string read_pack() const {
+        sfz::mapped_file file(pack_path());
+        return string(reinterpret_cast<const char*>(file.data().data()), file.data().size());
+    }
+
+    void write_pack(const string& contents) const {
+        pn::file f = pn::open(pack_path(), "w");
+        f.write(pn::data_view{reinterpret_cast<const uint8_t*>(contents.data()),
+                              int(contents.size())});
+    }
+
+  private:
+    TempDir             _dir;
+    map<string, string> _files;
+};
+
+MATCHER_P(HasContents, contents, "") {
+    return string(reinterpret_cast<const char*>(arg.data()), arg.size()) == contents;
+}
+
+// The hash that packs are sorted by, to check that colliding paths really collide.
+uint32_t fnv1a(const string& s) {
+    uint32_t hash = 2166136261u;
+    for (char ch : s) {
+        hash = (hash ^ uint8_t(ch)) * 16777619u;
+    }
+    return hash;
+}
+
+void expect_packed(const ResourcePack& pack, const map<string, string>& files) {
+    for (const auto& kv : files) {
+        pn::data_view data;
+        ASSERT_TRUE(pack.find(pn::string_view{kv.first.data(), int(kv.first.size())}, &data))
+                << kv.first;
+        EXPECT_THAT(data, HasContents(kv.second)) << kv.first;
+    }
+}
+
+TEST_F(ResourcePackTest, NoPack) {
+    put("a.txt", "a");
+    EXPECT_THAT(ResourcePack::open(dir()), testing::IsNull());
+}
+
+TEST_F(ResourcePackTest, RoundTrip) {
+    put("a.txt", "alpha");
+    put("b/c.txt", "charlie");
+    put("b/d/e.bin", string("\0\1\2\3\xff", 5));
+    put("b/d/f/g.txt", "golf");
+    put("empty", "");
+    put("b/also-empty", "");
+    put(".hidden", "not packed");
+
+    map<string, string> packed = files();
+    packed.erase(".hidden");
+    EXPECT_THAT(
+            ResourcePack::files(dir()),
+            testing::UnorderedElementsAre(
+                    "a.txt", "b/c.txt", "b/d/e.bin", "b/d/f/g.txt", "empty", "b/also-empty"));
+
+    ResourcePack::write(dir());
+    auto pack = ResourcePack::open(dir());
+    ASSERT_THAT(pack, testing::NotNull());
+    expect_packed(*pack, packed);
+
+    // The pack doesn't pack itself, and can be rewritten over an existing one.
+    EXPECT_THAT(
+            ResourcePack::files(dir()),
+            testing::Not(testing::Contains(ResourcePack::kFileName)));
+    ResourcePack::write(dir());
+    pack = ResourcePack::open(dir());
+    ASSERT_THAT(pack, testing::NotNull());
+    expect_packed(*pack, packed);
+
+    pn::data_view data;
+    EXPECT_FALSE(pack->find(".hidden", &data));
+    EXPECT_FALSE(pack->find("b", &data));
+    EXPECT_FALSE(pack->find("b/d", &data));
+    EXPECT_FALSE(pack->find("c.txt", &data));
+    EXPECT_FALSE(pack->find("a.txt/", &data));
+    EXPECT_FALSE(pack->find("", &data));
+    EXPECT_FALSE(pack->find(ResourcePack::kFileName, &data));
+}
+
+TEST_F(ResourcePackTest, Collisions) {
+    // Pairs of paths with the same FNV-1a hash.
+    const vector<std::pair<string, string>> collisions = {
+            {"costarring", "liquid"},
+            {"declinate", "macallums"},
+            {"altarage", "zinke"},
+    };
+    for (const auto& c : collisions) {
+        ASSERT_EQ(fnv1a(c.first), fnv1a(c.second)) << c.first << " " << c.second;
+        put(c.first, c.first + " contents");
+        put(c.second, c.second + " contents");
+    }
+    put("sub/liquid", "not the same liquid");
+    put("altarages", "altarages contents");
+
+    ResourcePack::write(dir());
+    auto pack = ResourcePack::open(dir());
+    ASSERT_THAT(pack, testing::NotNull());
+    expect_packed(*pack, files());
+
+    // Not in the pack, but colliding with a path that is.
+    ASSERT_EQ(fnv1a("altarages"), fnv1a("zinkes"));
+    pn::data_view data;
+    EXPECT_FALSE(pack->find("zinkes", &data));
+    EXPECT_FALSE(pack->find("liquids", &data));
+}
+
+TEST_F(ResourcePackTest, EmptyDirectory) {
+    ResourcePack::write(dir());
+    auto pack = ResourcePack::open(dir());
+    ASSERT_THAT(pack, testing::NotNull());
+    pn::data_view data;
+    EXPECT_FALSE(pack->find("anything", &data));
+    EXPECT_FALSE(pack->find("", &data));
+}
+
+TEST_F(ResourcePackTest, Damaged) {
+    put("a.txt", "alpha");
+    put("b/c.txt", "charlie");
+    put("empty", "");
+    ResourcePack::write(dir());
+    const string pack = read_pack();
+
+    // Every truncation cuts off some entry, path, or data.
+    for (int size = 0; size < pack.size(); ++size) {
+        write_pack(pack.substr(0, size));
+        EXPECT_THROW(ResourcePack::open(dir()), std::exception) << size;
+    }
+
+    string bad_magic = pack;
+    bad_magic[0]     = 'A';
+    write_pack(bad_magic);
+    EXPECT_THROW(ResourcePack::open(dir()), std::exception);
+
+    // A count too large for the table.
+    string bad_count = pack;
+    bad_count[8]     = '\x7f';
+    write_pack(bad_count);
+    EXPECT_THROW(ResourcePack::open(dir()), std::exception);
+
+    write_pack(pack);
+    auto reopened = ResourcePack::open(dir());
+    ASSERT_THAT(reopened, testing::NotNull());
+    expect_packed(*reopened, files());
+}
+
+TEST_F(ResourcePackTest, Resource) {
+    put("pictures/1.png", "picture one");
+    put("pictures/nested/2.png", "picture two");
+    put("sounds/3.aiff", string("\0sound\0", 7));
+    put("empty.txt", "");
+    ResourcePack::write(dir());
+
+    // Loose files are shadowed by the pack, so changing them changes nothing.
+    {
+        pn::file f = pn::open(pn::format("{0}/pictures/1.png", dir()), "w");
+        f.write(pn::string_view{"loose"});
+    }
+
+    NullPrefsDriver prefs;
+    set_application_path(dir());
+    set_factory_scenario_path(dir());
+    for (const auto& kv : files()) {
+        Resource r(pn::string_view{kv.first.data(), int(kv.first.size())});
+        EXPECT_THAT(r.data(), HasContents(kv.second)) << kv.first;
+        EXPECT_EQ(kv.second, string(r.string().data(), r.string().size())) << kv.first;
+    }
+    EXPECT_THROW(Resource("pictures/3.png"), std::runtime_error);
+    EXPECT_THROW(Resource("pictures/nested"), std::runtime_error);
+}
+
+}  // namespace
+}  // namespace antares
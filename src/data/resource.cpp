@@ -19,10 +19,18 @@
 #include "data/resource.hpp"
 
 #include <stdio.h>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <pn/file>
 #include <sfz/sfz.hpp>
+#include <string>
+#include <unordered_set>
+#include <vector>
 
 #include "config/dirs.hpp"
+#include "data/resource-pack.hpp"
+#include "lang/defines.hpp"
 
 using std::unique_ptr;
 
@@ -30,38 +38,113 @@ namespace path = sfz::path;
 
 namespace antares {
 
-static unique_ptr<sfz::mapped_file> load_first(
-        pn::string_view resource_path, const std::vector<pn::string_view>& dirs) {
-    for (const auto& dir : dirs) {
-        pn::string path = pn::format("{0}/{1}", dir, resource_path);
-        if (path::isfile(path)) {
-            return unique_ptr<sfz::mapped_file>(new sfz::mapped_file(path));
+namespace {
+
+// What one of the directories that resources are loaded from holds, read when it's first searched,
+// so that lookups answer from memory instead of probing the file system.  If the directory has a
+// pack, that's all there is to it; otherwise, the index lists its loose files.
+struct DirIndex {
+    std::string                         dir;
+    std::shared_ptr<const ResourcePack> pack;
+    std::unordered_set<std::string>     files;
+};
+
+struct Indexes {
+    std::mutex                                             mu;
+    std::string                                            scenario;
+    std::map<std::string, std::shared_ptr<const DirIndex>> dirs;
+    int64_t                                                hits   = 0;
+    int64_t                                                misses = 0;
+};
+
+Indexes& indexes() {
+    static ANTARES_GLOBAL Indexes indexes;
+    return indexes;
+}
+
+std::shared_ptr<const DirIndex> index(Indexes& x, pn::string_view dir) {
+    const std::string key(dir.data(), dir.size());
+    auto              it = x.dirs.find(key);
+    if (it != x.dirs.end()) {
+        return it->second;
+    }
+
+    std::shared_ptr<DirIndex> index(new DirIndex);
+    index->dir  = key;
+    index->pack = ResourcePack::open(dir);
+    if (!index->pack && path::isdir(dir)) {
+        for (std::string& file : ResourcePack::files(dir)) {
+            index->files.insert(std::move(file));
         }
     }
-    throw std::runtime_error(
-            pn::format("couldn't find resource {0}", pn::dump(resource_path, pn::dump_short))
-                    .c_str());
+    x.dirs[key] = index;
+    return index;
 }
 
-static unique_ptr<sfz::mapped_file> load(pn::string_view resource_path) {
+}  // namespace
+
+Resource::Resource(pn::string_view type, pn::string_view extension, int id)
+        : Resource(pn::format("{0}/{1}.{2}", type, id, extension)) {}
+
+Resource::Resource(pn::string_view resource_path) {
     pn::string      scenario = scenario_path();
     pn::string_view factory  = factory_scenario_path();
     pn::string_view app      = application_path();
-    return load_first(resource_path, {scenario, factory, app});
-}
 
-Resource::Resource(pn::string_view type, pn::string_view extension, int id)
-        : Resource(pn::format("{0}/{1}.{2}", type, id, extension)) {}
+    std::vector<std::shared_ptr<const DirIndex>> dirs;
+    {
+        Indexes&                     x = indexes();
+        std::unique_lock<std::mutex> lock(x.mu);
+        if (x.scenario != scenario.c_str()) {
+            // A different scenario is active, so start over in case anything was installed.
+            x.scenario = scenario.c_str();
+            x.dirs.clear();
+        }
+        for (pn::string_view dir : {pn::string_view{scenario}, factory, app}) {
+            dirs.push_back(index(x, dir));
+        }
+    }
 
-Resource::Resource(pn::string_view resource_path) : _file(load(resource_path)) {}
+    const std::string key(resource_path.data(), resource_path.size());
+    for (const auto& dir : dirs) {
+        const bool found = dir->pack ? dir->pack->find(resource_path, &_data)
+                                     : (dir->files.find(key) != dir->files.end());
+        {
+            Indexes&                     x = indexes();
+            std::unique_lock<std::mutex> lock(x.mu);
+            ++(found ? x.hits : x.misses);
+        }
+        if (!found) {
+            continue;
+        } else if (dir->pack) {
+            _pack = dir->pack;
+        } else {
+            pn::string path = pn::format("{0}/{1}", dir->dir.c_str(), resource_path);
+            _file.reset(new sfz::mapped_file(path));
+            _data = _file->data();
+        }
+        return;
+    }
+    throw std::runtime_error(
+            pn::format("couldn't find resource {0}", pn::dump(resource_path, pn::dump_short))
+                    .c_str());
+}
+
+pn::string Resource::stats() {
+    Indexes&                     x = indexes();
+    std::unique_lock<std::mutex> lock(x.mu);
+    return pn::format(
+            "resources: {0} directories indexed, {1} hits, {2} misses\n", int64_t(x.dirs.size()),
+            x.hits, x.misses);
+}
 
 Resource::~Resource() {}
 
-pn::data_view Resource::data() const { return _file->data(); }
+pn::data_view Resource::data() const { return _data; }
 
 pn::string_view Resource::string() const {
-    return pn::string_view{reinterpret_cast<const char*>(_file->data().data()),
-                           static_cast<int>(_file->data().size())};
+    return pn::string_view{reinterpret_cast<const char*>(_data.data()),
+                           static_cast<int>(_data.size())};
 }
 
 }  // namespace antares
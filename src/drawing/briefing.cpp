@@ -335,7 +335,7 @@ static void render_briefing_with(
         }
     }
 
-    gBriefingSpriteBounds.resize(kMaxSpaceObject);
+    gBriefingSpriteBounds.resize(SpaceObject::all().size());
 
     for (auto anObject : SpaceObject::all()) {
         Rect& rect = gBriefingSpriteBounds[anObject.number()];
@@ -1154,23 +1154,42 @@ void draw_labeled_box(Point origin, const LabeledRect& item) {
     mDrawPuffUpRect(Rects(), uRect, item.hue, VERY_DARK);
 }
 
-void draw_text_rect(Point origin, const TextRect& item) {
+void draw_text_rect(Point origin, const TextRect& item, InterfaceTextCache* texts) {
     Rect bounds = item.bounds();
     bounds.offset(origin.h, origin.v);
-    draw_text_in_rect(bounds, item.text, item.style, item.hue);
+    if (texts) {
+        (*texts)[&item].draw(bounds, item.text, item.style, item.hue);
+    } else {
+        draw_text_in_rect(bounds, item.text, item.style, item.hue);
+    }
 }
 
 }  // namespace
 
 void draw_text_in_rect(
         Rect tRect, pn::string_view text, interfaceStyleType style, uint8_t textcolor) {
-    RgbColor   color = GetRGBTranslateColorShade(textcolor, VERY_LIGHT);
-    StyledText interface_text(interface_font(style));
-    interface_text.set_fore_color(color);
-    interface_text.set_interface_text(text);
-    interface_text.wrap_to(tRect.width(), kInterfaceTextHBuffer, kInterfaceTextVBuffer);
+    InterfaceText().draw(tRect, text, style, textcolor);
+}
+
+InterfaceText::InterfaceText() : _style(kLarge), _textcolor(0), _width(-1) {}
+
+InterfaceText::~InterfaceText() {}
+
+void InterfaceText::draw(
+        Rect tRect, pn::string_view text, interfaceStyleType style, uint8_t textcolor) {
+    if (!_styled || (_text != text) || (_style != style) || (_textcolor != textcolor) ||
+        (_width != tRect.width())) {
+        _text      = text.copy();
+        _style     = style;
+        _textcolor = textcolor;
+        _width     = tRect.width();
+        _styled.reset(new StyledText(interface_font(style)));
+        _styled->set_fore_color(GetRGBTranslateColorShade(textcolor, VERY_LIGHT));
+        _styled->set_interface_text(text);
+        _styled->wrap_to(_width, kInterfaceTextHBuffer, kInterfaceTextVBuffer);
+    }
     tRect.offset(0, -kInterfaceTextVBuffer);
-    interface_text.draw(tRect);
+    _styled->draw(tRect);
 }
 
 int16_t GetInterfaceTextHeightFromWidth(
@@ -1193,13 +1212,15 @@ void draw_picture_rect(Point origin, const PictureRect& item) {
 namespace {
 
 struct DrawInterfaceItemVisitor : InterfaceItem::Visitor {
-    Point     p;
-    InputMode mode;
-    DrawInterfaceItemVisitor(Point p, InputMode mode) : p(p), mode(mode) {}
+    Point               p;
+    InputMode           mode;
+    InterfaceTextCache* texts;
+    DrawInterfaceItemVisitor(Point p, InputMode mode, InterfaceTextCache* texts)
+            : p(p), mode(mode), texts(texts) {}
 
     virtual void visit_plain_rect(const PlainRect& i) const { draw_plain_rect(p, i); }
     virtual void visit_labeled_rect(const LabeledRect& i) const { draw_labeled_box(p, i); }
-    virtual void visit_text_rect(const TextRect& i) const { draw_text_rect(p, i); }
+    virtual void visit_text_rect(const TextRect& i) const { draw_text_rect(p, i, texts); }
     virtual void visit_picture_rect(const PictureRect& i) const { draw_picture_rect(p, i); }
     virtual void visit_plain_button(const PlainButton& i) const { draw_button(p, mode, i); }
     virtual void visit_radio_button(const RadioButton& i) const {}
@@ -1316,11 +1337,16 @@ struct GetBoundsInterfaceItemVisitor : InterfaceItem::Visitor {
 }  // namespace
 
 void draw_interface_item(const InterfaceItem& item, InputMode mode) {
-    item.accept(DrawInterfaceItemVisitor({0, 0}, mode));
+    item.accept(DrawInterfaceItemVisitor({0, 0}, mode, nullptr));
 }
 
 void draw_interface_item(const InterfaceItem& item, InputMode mode, Point origin) {
-    item.accept(DrawInterfaceItemVisitor(origin, mode));
+    item.accept(DrawInterfaceItemVisitor(origin, mode, nullptr));
+}
+
+void draw_interface_item(
+        const InterfaceItem& item, InputMode mode, Point origin, InterfaceTextCache* texts) {
+    item.accept(DrawInterfaceItemVisitor(origin, mode, texts));
 }
 
 void GetAnyInterfaceItemGraphicBounds(const InterfaceItem& item, Rect* bounds) {
@@ -0,0 +1,325 @@
+// Copyright (C) 1997, 1999-2001, 2008 Nathan Lamont
+// Copyright (C) 2008-2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#include "drawing/pix-kernels.hpp"
+
+#include <string.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#include <immintrin.h>
+#define ANTARES_AVX2 __attribute__((target("avx2")))
+#endif
+
+namespace antares {
+
+// The vector kernels treat each pixel as a little-endian 32-bit word: alpha in the low byte, then
+// red, green, and blue.
+static_assert(sizeof(RgbColor) == 4, "RgbColor must be packed");
+
+namespace {
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Scalar
+
+void scalar_fill(RgbColor* row, int count, RgbColor color) {
+    for (int i = 0; i < count; ++i) {
+        row[i] = color;
+    }
+}
+
+// Straight (not pre-multiplied) alpha, in integers.  Fully opaque and fully transparent pixels of
+// `over` are exact, so the vector kernels can handle those themselves and leave the rest here.
+inline void composite_pixel(RgbColor* under, const RgbColor& over) {
+    const int oa = over.alpha;
+    const int ua = under->alpha;
+    if (oa == 0xff) {
+        *under = over;
+        return;
+    } else if (oa == 0x00) {
+        return;
+    }
+    const int ow    = oa * 255;
+    const int uw    = ua * (255 - oa);
+    const int alpha = ow + uw;  // nonzero, since oa is.
+    *under          = rgba(
+            ((over.red * ow) + (under->red * uw)) / alpha,
+            ((over.green * ow) + (under->green * uw)) / alpha,
+            ((over.blue * ow) + (under->blue * uw)) / alpha, alpha / 255);
+}
+
+void scalar_composite(RgbColor* under, const RgbColor* over, int count) {
+    for (int i = 0; i < count; ++i) {
+        composite_pixel(&under[i], over[i]);
+    }
+}
+
+inline void tint_pixel(RgbColor* under, const RgbColor& overlay, uint8_t color) {
+    const RgbColor over = RgbColor::tint(color, overlay.red);
+    const int      frac = overlay.alpha;
+    RgbColor       composite;
+    composite.red   = ((over.red * frac) + (under->red * (255 - frac))) / 255;
+    composite.green = ((over.green * frac) + (under->green * (255 - frac))) / 255;
+    composite.blue  = ((over.blue * frac) + (under->blue * (255 - frac))) / 255;
+    composite.alpha = under->alpha;
+    *under          = composite;
+}
+
+void scalar_tint(RgbColor* under, const RgbColor* overlay, int count, uint8_t color) {
+    for (int i = 0; i < count; ++i) {
+        tint_pixel(&under[i], overlay[i], color);
+    }
+}
+
+inline void from_bgra_pixel(RgbColor* out, const uint8_t* bgra) {
+    *out = rgb(bgra[2], bgra[1], bgra[0]);
+}
+
+void scalar_from_bgra(RgbColor* row, const uint8_t* bgra, int count) {
+    for (int i = 0; i < count; ++i) {
+        from_bgra_pixel(&row[i], bgra + (4 * i));
+    }
+}
+
+// The shade of each channel is `(diffuse * value / 255) + ambient`; see RgbColor::tint().
+struct Shade {
+    int16_t diffuse[3];
+    int16_t ambient[3];
+    Shade(uint8_t color) {
+        const RgbColor dark  = RgbColor::tint(color, 0);
+        const RgbColor light = RgbColor::tint(color, 255);
+        diffuse[0]           = light.red - dark.red;
+        diffuse[1]           = light.green - dark.green;
+        diffuse[2]           = light.blue - dark.blue;
+        ambient[0]           = dark.red;
+        ambient[1]           = dark.green;
+        ambient[2]           = dark.blue;
+    }
+};
+
+#if defined(__SSE2__)
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// SSE2
+
+// x / 255, rounded down, for each 16-bit x in [0, 255 * 255].
+inline __m128i div255(__m128i x) {
+    return _mm_srli_epi16(
+            _mm_add_epi16(_mm_add_epi16(x, _mm_set1_epi16(1)), _mm_srli_epi16(x, 8)), 8);
+}
+
+void sse2_fill(RgbColor* row, int count, RgbColor color) {
+    int32_t bits;
+    memcpy(&bits, &color, 4);
+    const __m128i v = _mm_set1_epi32(bits);
+    int           i = 0;
+    for (; (i + 4) <= count; i += 4) {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(row + i), v);
+    }
+    scalar_fill(row + i, count - i, color);
+}
+
+void sse2_composite(RgbColor* under, const RgbColor* over, int count) {
+    const __m128i alpha = _mm_set1_epi32(0xff);
+    int           i     = 0;
+    for (; (i + 4) <= count; i += 4) {
+        const __m128i o           = _mm_loadu_si128(reinterpret_cast<const __m128i*>(over + i));
+        const __m128i oa          = _mm_and_si128(o, alpha);
+        const __m128i opaque      = _mm_cmpeq_epi32(oa, alpha);
+        const __m128i transparent = _mm_cmpeq_epi32(oa, _mm_setzero_si128());
+        const int     either      = _mm_movemask_epi8(_mm_or_si128(opaque, transparent));
+        if (either != 0xffff) {
+            scalar_composite(under + i, over + i, 4);  // some pixels need blending.
+        } else if (_mm_movemask_epi8(opaque) != 0) {
+            __m128i*      out = reinterpret_cast<__m128i*>(under + i);
+            const __m128i u   = _mm_loadu_si128(out);
+            _mm_storeu_si128(
+                    out, _mm_or_si128(_mm_and_si128(opaque, o), _mm_andnot_si128(opaque, u)));
+        }
+    }
+    scalar_composite(under + i, over + i, count - i);
+}
+
+// Tints two pixels, unpacked to 16 bits per channel.
+inline __m128i sse2_tint2(__m128i under, __m128i overlay, __m128i diffuse, __m128i ambient) {
+    const __m128i value = _mm_shufflehi_epi16(_mm_shufflelo_epi16(overlay, 0x55), 0x55);
+    const __m128i frac  = _mm_shufflehi_epi16(_mm_shufflelo_epi16(overlay, 0x00), 0x00);
+    const __m128i over  = _mm_add_epi16(div255(_mm_mullo_epi16(diffuse, value)), ambient);
+    const __m128i rest  = _mm_sub_epi16(_mm_set1_epi16(255), frac);
+    return div255(_mm_add_epi16(_mm_mullo_epi16(over, frac), _mm_mullo_epi16(under, rest)));
+}
+
+void sse2_tint(RgbColor* under, const RgbColor* overlay, int count, uint8_t color) {
+    const Shade   s(color);
+    const __m128i diffuse = _mm_setr_epi16(
+            0, s.diffuse[0], s.diffuse[1], s.diffuse[2], 0, s.diffuse[0], s.diffuse[1],
+            s.diffuse[2]);
+    const __m128i ambient = _mm_setr_epi16(
+            0, s.ambient[0], s.ambient[1], s.ambient[2], 0, s.ambient[0], s.ambient[1],
+            s.ambient[2]);
+    const __m128i alpha = _mm_set1_epi32(0xff);
+    const __m128i zero  = _mm_setzero_si128();
+    int           i     = 0;
+    for (; (i + 4) <= count; i += 4) {
+        __m128i*      out = reinterpret_cast<__m128i*>(under + i);
+        const __m128i u   = _mm_loadu_si128(out);
+        const __m128i o   = _mm_loadu_si128(reinterpret_cast<const __m128i*>(overlay + i));
+        const __m128i lo  = sse2_tint2(
+                _mm_unpacklo_epi8(u, zero), _mm_unpacklo_epi8(o, zero), diffuse, ambient);
+        const __m128i hi = sse2_tint2(
+                _mm_unpackhi_epi8(u, zero), _mm_unpackhi_epi8(o, zero), diffuse, ambient);
+        const __m128i tinted = _mm_packus_epi16(lo, hi);
+        _mm_storeu_si128(
+                out, _mm_or_si128(_mm_andnot_si128(alpha, tinted), _mm_and_si128(alpha, u)));
+    }
+    scalar_tint(under + i, overlay + i, count - i, color);
+}
+
+// BGRA is the byte-reverse of ARGB, with alpha forced to opaque.
+void sse2_from_bgra(RgbColor* row, const uint8_t* bgra, int count) {
+    const __m128i green = _mm_set1_epi32(0x00ff0000);
+    const __m128i red   = _mm_set1_epi32(0x0000ff00);
+    const __m128i alpha = _mm_set1_epi32(0x000000ff);
+    int           i     = 0;
+    for (; (i + 4) <= count; i += 4) {
+        const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bgra + (4 * i)));
+        const __m128i y = _mm_or_si128(
+                _mm_or_si128(_mm_slli_epi32(x, 24), _mm_and_si128(_mm_slli_epi32(x, 8), green)),
+                _mm_or_si128(_mm_and_si128(_mm_srli_epi32(x, 8), red), alpha));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(row + i), y);
+    }
+    scalar_from_bgra(row + i, bgra + (4 * i), count - i);
+}
+
+const PixelKernels kSse2PixelKernels = {
+        sse2_fill, sse2_composite, sse2_tint, sse2_from_bgra,
+};
+
+#endif  // defined(__SSE2__)
+
+#if defined(ANTARES_AVX2) && defined(__SSE2__)
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// AVX2
+//
+// Only filling and tinting are worth widening; tinting is most of the work of loading a sprite.
+// The 256-bit unpack, shuffle, and pack instructions work within each 128-bit half, so the
+// arithmetic is the same as SSE2's, two halves at a time.
+
+ANTARES_AVX2 inline __m256i avx2_div255(__m256i x) {
+    return _mm256_srli_epi16(
+            _mm256_add_epi16(_mm256_add_epi16(x, _mm256_set1_epi16(1)), _mm256_srli_epi16(x, 8)),
+            8);
+}
+
+ANTARES_AVX2 void avx2_fill(RgbColor* row, int count, RgbColor color) {
+    int32_t bits;
+    memcpy(&bits, &color, 4);
+    const __m256i v = _mm256_set1_epi32(bits);
+    int           i = 0;
+    for (; (i + 8) <= count; i += 8) {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(row + i), v);
+    }
+    scalar_fill(row + i, count - i, color);
+}
+
+ANTARES_AVX2 inline __m256i avx2_tint4(
+        __m256i under, __m256i overlay, __m256i diffuse, __m256i ambient) {
+    const __m256i value = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(overlay, 0x55), 0x55);
+    const __m256i frac  = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(overlay, 0x00), 0x00);
+    const __m256i over =
+            _mm256_add_epi16(avx2_div255(_mm256_mullo_epi16(diffuse, value)), ambient);
+    const __m256i rest  = _mm256_sub_epi16(_mm256_set1_epi16(255), frac);
+    return avx2_div255(
+            _mm256_add_epi16(_mm256_mullo_epi16(over, frac), _mm256_mullo_epi16(under, rest)));
+}
+
+ANTARES_AVX2 void avx2_tint(RgbColor* under, const RgbColor* overlay, int count, uint8_t color) {
+    const Shade   s(color);
+    const __m256i diffuse = _mm256_setr_epi16(
+            0, s.diffuse[0], s.diffuse[1], s.diffuse[2], 0, s.diffuse[0], s.diffuse[1],
+            s.diffuse[2], 0, s.diffuse[0], s.diffuse[1], s.diffuse[2], 0, s.diffuse[0],
+            s.diffuse[1], s.diffuse[2]);
+    const __m256i ambient = _mm256_setr_epi16(
+            0, s.ambient[0], s.ambient[1], s.ambient[2], 0, s.ambient[0], s.ambient[1],
+            s.ambient[2], 0, s.ambient[0], s.ambient[1], s.ambient[2], 0, s.ambient[0],
+            s.ambient[1], s.ambient[2]);
+    const __m256i alpha = _mm256_set1_epi32(0xff);
+    const __m256i zero  = _mm256_setzero_si256();
+    int           i     = 0;
+    for (; (i + 8) <= count; i += 8) {
+        __m256i*      out = reinterpret_cast<__m256i*>(under + i);
+        const __m256i u   = _mm256_loadu_si256(out);
+        const __m256i o   = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(overlay + i));
+        const __m256i lo  = avx2_tint4(
+                _mm256_unpacklo_epi8(u, zero), _mm256_unpacklo_epi8(o, zero), diffuse, ambient);
+        const __m256i hi = avx2_tint4(
+                _mm256_unpackhi_epi8(u, zero), _mm256_unpackhi_epi8(o, zero), diffuse, ambient);
+        const __m256i tinted = _mm256_packus_epi16(lo, hi);
+        _mm256_storeu_si256(
+                out,
+                _mm256_or_si256(_mm256_andnot_si256(alpha, tinted), _mm256_and_si256(alpha, u)));
+    }
+    sse2_tint(under + i, overlay + i, count - i, color);
+}
+
+const PixelKernels kAvx2PixelKernels = {
+        avx2_fill, sse2_composite, avx2_tint, sse2_from_bgra,
+};
+
+#endif  // defined(ANTARES_AVX2) && defined(__SSE2__)
+
+}  // namespace
+
+const PixelKernels kScalarPixelKernels = {
+        scalar_fill, scalar_composite, scalar_tint, scalar_from_bgra,
+};
+
+const PixelKernels* sse2_pixel_kernels() {
+#if defined(__SSE2__)
+    return &kSse2PixelKernels;
+#else
+    return nullptr;
+#endif
+}
+
+const PixelKernels* avx2_pixel_kernels() {
+#if defined(ANTARES_AVX2) && defined(__SSE2__)
+    if (__builtin_cpu_supports("avx2")) {
+        return &kAvx2PixelKernels;
+    }
+#endif
+    return nullptr;
+}
+
+const PixelKernels& pixel_kernels() {
+    static const PixelKernels* kernels = []() -> const PixelKernels* {
+        if (const PixelKernels* k = avx2_pixel_kernels()) {
+            return k;
+        } else if (const PixelKernels* k = sse2_pixel_kernels()) {
+            return k;
+        }
+        return &kScalarPixelKernels;
+    }();
+    return *kernels;
+}
+
+}  // namespace antares
@@ -0,0 +1,172 @@
+// Copyright (C) 1997, 1999-2001, 2008 Nathan Lamont
+// Copyright (C) 2008-2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#include "drawing/pix-kernels.hpp"
+
+#include <gmock/gmock.h>
+#include <random>
+#include <utility>
+#include <vector>
+
+using std::vector;
+
+namespace antares {
+namespace {
+
+typedef testing::Test PixKernelsTest;
+
+// Rows up to this long cover the vector loops and every length of scalar tail after them.
+const int kMaxCount = 40;
+
+// Offsets of the first pixel from the start of the buffer, so that unaligned rows are covered.
+const int kMaxOffset = 4;
+
+vector<std::pair<const char*, const PixelKernels*>> vector_kernels() {
+    vector<std::pair<const char*, const PixelKernels*>> kernels;
+    if (sse2_pixel_kernels()) {
+        kernels.emplace_back("sse2", sse2_pixel_kernels());
+    }
+    if (avx2_pixel_kernels()) {
+        kernels.emplace_back("avx2", avx2_pixel_kernels());
+    }
+    return kernels;
+}
+
+// Runs of opaque, transparent, and translucent pixels, so the vector kernels take each of their
+// paths.
+vector<RgbColor> random_pixels(std::mt19937& rng, int count) {
+    vector<RgbColor> pixels;
+    while (pixels.size() < count) {
+        const int run  = rng() % 12;
+        const int kind = rng() % 3;
+        for (int i = 0; i < run; ++i) {
+            uint8_t alpha = rng();
+            if (kind == 0) {
+                alpha = 0xff;
+            } else if (kind == 1) {
+                alpha = 0x00;
+            }
+            pixels.push_back(rgba(rng(), rng(), rng(), alpha));
+        }
+    }
+    pixels.resize(count);
+    return pixels;
+}
+
+TEST_F(PixKernelsTest, Scalar) {
+    const PixelKernels& k = kScalarPixelKernels;
+
+    RgbColor row[3] = {rgb(1, 2, 3), rgb(1, 2, 3), rgb(1, 2, 3)};
+    k.fill(row, 2, rgba(4, 5, 6, 7));
+    EXPECT_EQ(rgba(4, 5, 6, 7), row[0]);
+    EXPECT_EQ(rgba(4, 5, 6, 7), row[1]);
+    EXPECT_EQ(rgb(1, 2, 3), row[2]);
+
+    const RgbColor over[3] = {rgb(255, 0, 0), rgba(255, 0, 0, 0), rgba(255, 0, 0, 51)};
+    RgbColor       under[3] = {rgb(0, 0, 255), rgb(0, 0, 255), rgb(0, 0, 255)};
+    k.composite(under, over, 3);
+    EXPECT_EQ(rgb(255, 0, 0), under[0]);
+    EXPECT_EQ(rgb(0, 0, 255), under[1]);
+    EXPECT_EQ(rgb(51, 0, 204), under[2]);
+
+    const RgbColor overlay[2] = {rgba(255, 0, 0, 0), rgba(255, 0, 0, 255)};
+    RgbColor       tinted[2]  = {rgba(1, 2, 3, 4), rgba(1, 2, 3, 4)};
+    k.tint(tinted, overlay, 2, 0);
+    EXPECT_EQ(rgba(1, 2, 3, 4), tinted[0]);
+    EXPECT_EQ(rgba(255, 255, 255, 4), tinted[1]);
+
+    const uint8_t bgra[4] = {1, 2, 3, 4};
+    k.from_bgra(row, bgra, 1);
+    EXPECT_EQ(rgb(3, 2, 1), row[0]);
+}
+
+TEST_F(PixKernelsTest, Fill) {
+    std::mt19937 rng(1);
+    for (const auto& kernels : vector_kernels()) {
+        for (int count = 0; count <= kMaxCount; ++count) {
+            for (int offset = 0; offset < kMaxOffset; ++offset) {
+                const RgbColor   color    = rgba(rng(), rng(), rng(), rng());
+                vector<RgbColor> expected = random_pixels(rng, offset + count + 1);
+                vector<RgbColor> actual   = expected;
+                kScalarPixelKernels.fill(&expected[offset], count, color);
+                kernels.second->fill(&actual[offset], count, color);
+                ASSERT_THAT(actual, testing::ContainerEq(expected))
+                        << kernels.first << " " << count << "+" << offset;
+            }
+        }
+    }
+}
+
+TEST_F(PixKernelsTest, Composite) {
+    std::mt19937 rng(2);
+    for (const auto& kernels : vector_kernels()) {
+        for (int count = 0; count <= kMaxCount; ++count) {
+            for (int offset = 0; offset < kMaxOffset; ++offset) {
+                const vector<RgbColor> over     = random_pixels(rng, offset + count + 1);
+                vector<RgbColor>       expected = random_pixels(rng, offset + count + 1);
+                vector<RgbColor>       actual   = expected;
+                kScalarPixelKernels.composite(&expected[offset], &over[offset], count);
+                kernels.second->composite(&actual[offset], &over[offset], count);
+                ASSERT_THAT(actual, testing::ContainerEq(expected))
+                        << kernels.first << " " << count << "+" << offset;
+            }
+        }
+    }
+}
+
+TEST_F(PixKernelsTest, Tint) {
+    std::mt19937 rng(3);
+    for (const auto& kernels : vector_kernels()) {
+        for (int color = 0; color < 16; ++color) {
+            for (int count = 0; count <= kMaxCount; ++count) {
+                for (int offset = 0; offset < kMaxOffset; ++offset) {
+                    const vector<RgbColor> overlay  = random_pixels(rng, offset + count + 1);
+                    vector<RgbColor>       expected = random_pixels(rng, offset + count + 1);
+                    vector<RgbColor>       actual   = expected;
+                    kScalarPixelKernels.tint(&expected[offset], &overlay[offset], count, color);
+                    kernels.second->tint(&actual[offset], &overlay[offset], count, color);
+                    ASSERT_THAT(actual, testing::ContainerEq(expected))
+                            << kernels.first << " " << color << " " << count << "+" << offset;
+                }
+            }
+        }
+    }
+}
+
+TEST_F(PixKernelsTest, FromBgra) {
+    std::mt19937 rng(4);
+    for (const auto& kernels : vector_kernels()) {
+        for (int count = 0; count <= kMaxCount; ++count) {
+            for (int offset = 0; offset < kMaxOffset; ++offset) {
+                vector<uint8_t> bgra(4 * (offset + count + 1));
+                for (uint8_t& byte : bgra) {
+                    byte = rng();
+                }
+                vector<RgbColor> expected = random_pixels(rng, offset + count + 1);
+                vector<RgbColor> actual   = expected;
+                kScalarPixelKernels.from_bgra(&expected[offset], &bgra[4 * offset], count);
+                kernels.second->from_bgra(&actual[offset], &bgra[4 * offset], count);
+                ASSERT_THAT(actual, testing::ContainerEq(expected))
+                        << kernels.first << " " << count << "+" << offset;
+            }
+        }
+    }
+}
+
+}  // namespace
+}  // namespace antares
@@ -22,6 +22,7 @@
 #include <pn/file>
 #include <sfz/sfz.hpp>
 
+#include "drawing/pix-kernels.hpp"
 #include "lang/casts.hpp"
 
 namespace antares {
@@ -37,13 +38,9 @@ const RgbColor& PixMap::get(int x, int y) const { return row(y)[x]; }
 void PixMap::set(int x, int y, const RgbColor& color) { mutable_row(y)[x] = color; }
 
 void PixMap::fill(const RgbColor& color) {
-    if (size().height > 0) {
-        for (int x = 0; x < size().width; ++x) {
-            set(x, 0, color);
-        }
-        for (int y = 1; y < size().height; ++y) {
-            memcpy(mutable_row(y), row(y - 1), size().width * sizeof(RgbColor));
-        }
+    const PixelKernels& k = pixel_kernels();
+    for (int y = 0; y < size().height; ++y) {
+        k.fill(mutable_row(y), size().width, color);
     }
 }
 
@@ -60,22 +57,11 @@ void PixMap::composite(const PixMap& pix) {
     if (size() != pix.size()) {
         throw std::runtime_error("Mismatch in PixMap sizes");
     }
+    // TODO(sfiera): if we're going to do anything like this in the long run, we should require
+    // that alpha be pre-multiplied with the color components.
+    const PixelKernels& k = pixel_kernels();
     for (int y = 0; y < size().height; ++y) {
-        for (int x = 0; x < size().width; ++x) {
-            const RgbColor& over  = pix.get(x, y);
-            const double    oa    = over.alpha / 255.0;
-            const RgbColor& under = get(x, y);
-            const double    ua    = under.alpha / 255.0;
-
-            // TODO(sfiera): if we're going to do anything like this in the long run, we should
-            // require that alpha be pre-multiplied with the color components.  We should probably
-            // also use integral arithmetic.
-            double red   = (over.red * oa) + ((under.red * ua) * (1.0 - oa));
-            double green = (over.green * oa) + ((under.green * ua) * (1.0 - oa));
-            double blue  = (over.blue * oa) + ((under.blue * ua) * (1.0 - oa));
-            double alpha = oa + (ua * (1.0 - oa));
-            set(x, y, rgba(red / alpha, green / alpha, blue / alpha, alpha * 255));
-        }
+        k.composite(mutable_row(y), pix.row(y), size().width);
     }
 }
 
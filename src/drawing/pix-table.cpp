@@ -18,14 +18,21 @@
 
 #include "drawing/pix-table.hpp"
 
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <atomic>
 #include <pn/array>
 #include <pn/file>
 #include <pn/map>
 #include <sfz/sfz.hpp>
 
+#include "config/dirs.hpp"
 #include "data/resource.hpp"
 #include "drawing/color.hpp"
+#include "drawing/pix-kernels.hpp"
 #include "game/sys.hpp"
+#include "lang/defines.hpp"
 #include "video/driver.hpp"
 
 using sfz::StringMap;
@@ -35,12 +42,71 @@ using std::vector;
 
 namespace antares {
 
-static ArrayPixMap load_image(pn::string_view path) {
-    Resource rsrc(path);
-    return read_png(rsrc.data().open());
+namespace {
+
+// Tinted frames are cached in the cache directory, keyed by a hash of everything they're made
+// from.  When a sprite's sources change, its key changes, and it's rebuilt under the new key.
+// Cache files are native-endian: they're only read on the machine that wrote them.
+const char kCacheMagic[]  = "antspr01";
+const char kCacheFormat[] = "sprite cache 1";  // change to invalidate all cached sprites.
+
+struct CachedFrame {
+    int32_t left, top, right, bottom;
+};
+
+// FNV-1a.
+void hash(uint64_t* h, pn::data_view data) {
+    for (int i = 0; i < data.size(); ++i) {
+        *h = (*h ^ data.data()[i]) * 1099511628211ull;
+    }
+}
+
+void hash(uint64_t* h, int64_t value) {
+    hash(h, pn::data_view{reinterpret_cast<const uint8_t*>(&value), sizeof(value)});
+}
+
+uint64_t cache_key(
+        pn::data_view sprite, pn::data_view image, pn::data_view overlay, uint8_t color) {
+    uint64_t h = 14695981039346656037ull;
+    hash(&h, pn::data_view{reinterpret_cast<const uint8_t*>(kCacheFormat),
+                           sizeof(kCacheFormat)});
+    hash(&h, color);
+    for (pn::data_view d : {sprite, image, overlay}) {
+        hash(&h, d.size());
+        hash(&h, d);
+    }
+    return h;
+}
+
+pn::string cache_path(uint64_t key) {
+    if (dirs().cache.empty()) {
+        return "";
+    }
+    char hex[17];
+    snprintf(hex, sizeof(hex), "%016llx", static_cast<unsigned long long>(key));
+    return pn::format("{0}/sprites/{1}", dirs().cache, hex);
+}
+
+template <typename T>
+bool read_cached(const uint8_t** in, const uint8_t* end, T* value) {
+    if ((end - *in) < sizeof(T)) {
+        return false;
+    }
+    memcpy(value, *in, sizeof(T));
+    *in += sizeof(T);
+    return true;
+}
+
+template <typename T>
+void write_cached(pn::file_view out, const T& value) {
+    out.write(pn::data_view{reinterpret_cast<const uint8_t*>(&value), sizeof(T)});
 }
 
-NatePixTable::NatePixTable(int id, uint8_t color) {
+}  // namespace
+
+static ArrayPixMap load_image(const Resource& rsrc) { return read_png(rsrc.data().open()); }
+
+NatePixTable::NatePixTable(int id, uint8_t color) : _id(id) {
     Resource  rsrc("sprites", "pn", id);
     pn::value x;
     if (!pn::parse(rsrc.string().open(), x, nullptr)) {
@@ -48,6 +114,21 @@ NatePixTable::NatePixTable(int id, uint8_t color) {
     }
     pn::map_cref m = x.as_map();
 
+    Resource   image(m.get("image").as_string());
+    Resource   overlay(m.get("overlay").as_string());
+    pn::string path = cache_path(cache_key(rsrc.data(), image.data(), overlay.data(), color));
+    if (!path.empty() && load_cached(path)) {
+        return;
+    }
+
+    load(m, image, overlay, color);
+    if (!path.empty()) {
+        save_cached(path);
+    }
+}
+
+void NatePixTable::load(
+        pn::map_cref m, const Resource& image, const Resource& overlay, uint8_t color) {
     struct State {
         int         rows, cols;
         Point       center;
@@ -60,8 +141,8 @@ NatePixTable::NatePixTable(int id, uint8_t color) {
     state.center       = Point(point.get("x").as_int(), point.get("y").as_int());
     state.rows         = m.get("rows").as_int();
     state.cols         = m.get("cols").as_int();
-    state.image        = load_image(m.get("image").as_string());
-    state.overlay      = load_image(m.get("overlay").as_string());
+    state.image        = load_image(image);
+    state.overlay      = load_image(overlay);
 
     if (state.image.size() != state.overlay.size()) {
         throw std::runtime_error("size mismatch between image and overlay");
@@ -94,54 +175,118 @@ NatePixTable::NatePixTable(int id, uint8_t color) {
         bounds.offset(2 * -bounds.left, 2 * -bounds.top);
         if (color) {
             _frames.emplace_back(
-                    bounds, state.image.view(cell).view(sprite), id, frame,
+                    bounds, state.image.view(cell).view(sprite),
                     state.overlay.view(cell).view(sprite), color);
         } else {
-            _frames.emplace_back(bounds, state.image.view(cell).view(sprite), id, frame);
+            _frames.emplace_back(bounds, state.image.view(cell).view(sprite));
         }
     }
 }
 
+// Returns false if there is no cache file at `path`, or if it's damaged, in which case it will be
+// overwritten.
+bool NatePixTable::load_cached(pn::string_view path) {
+    if (!sfz::path::isfile(path)) {
+        return false;
+    }
+    sfz::mapped_file file(path);
+    const uint8_t*   in  = file.data().data();
+    const uint8_t*   end = in + file.data().size();
+    char             magic[8];
+    uint32_t         count;
+    if (!read_cached(&in, end, &magic) || (memcmp(magic, kCacheMagic, 8) != 0) ||
+        !read_cached(&in, end, &count)) {
+        return false;
+    }
+
+    std::vector<Frame> frames;
+    for (int frame = 0; frame < count; ++frame) {
+        CachedFrame f;
+        if (!read_cached(&in, end, &f)) {
+            return false;
+        }
+        const Rect    bounds(f.left, f.top, f.right, f.bottom);
+        const int64_t size = int64_t(bounds.width()) * bounds.height() * sizeof(RgbColor);
+        if ((bounds.width() < 0) || (bounds.height() < 0) || ((end - in) < size)) {
+            return false;
+        }
+        ArrayPixMap pix(bounds.width(), bounds.height());
+        memcpy(pix.mutable_bytes(), in, size);
+        in += size;
+        frames.emplace_back(bounds, std::move(pix));
+    }
+    _frames = std::move(frames);
+    return true;
+}
+
+// The cache is only an optimization, so failing to write it isn't an error.  Frames are written
+// to a temporary file and renamed into place, so a damaged cache file is never seen.  Sprites
+// are loaded on several threads, and several processes may share a cache, so each writer has a
+// temporary file of its own; if two write the same sprite, the last rename wins, and both wrote
+// the same frames.
+void NatePixTable::save_cached(pn::string_view path) const {
+    static ANTARES_GLOBAL std::atomic<int64_t> serial{0};
+    pn::string                                 tmp_path =
+            pn::format("{0}.{1}.{2}.tmp", path, int64_t{getpid()}, int64_t{serial++});
+    try {
+        sfz::makedirs(sfz::path::dirname(path), 0755);
+        pn::file out = pn::open(tmp_path, "w");
+        out.write(pn::data_view{reinterpret_cast<const uint8_t*>(kCacheMagic), 8});
+        write_cached<uint32_t>(out, _frames.size());
+        for (const Frame& frame : _frames) {
+            const Rect bounds(frame.center(), Size(frame.width(), frame.height()));
+            write_cached(out, CachedFrame{bounds.left, bounds.top, bounds.right, bounds.bottom});
+            out.write(pn::data_view{
+                    reinterpret_cast<const uint8_t*>(frame.pix_map().bytes()),
+                    int(frame.width() * frame.height() * sizeof(RgbColor))});
+        }
+        if (out.error()) {
+            unlink(tmp_path.c_str());
+            return;
+        }
+    } catch (std::exception&) {
+        unlink(tmp_path.c_str());
+        return;
+    }
+    if (rename(tmp_path.c_str(), path.copy().c_str()) < 0) {
+        unlink(tmp_path.c_str());
+    }
+}
+
 NatePixTable::~NatePixTable() {}
 
+void NatePixTable::build() {
+    for (int i = 0; i < _frames.size(); ++i) {
+        _frames[i].build(_id, i);
+    }
+}
+
 const NatePixTable::Frame& NatePixTable::at(size_t index) const { return _frames[index]; }
 
-size_t NatePixTable::size() const { return _size; }
+size_t NatePixTable::size() const { return _frames.size(); }
 
-NatePixTable::Frame::Frame(
-        Rect bounds, const PixMap& image, int16_t id, int frame, const PixMap& overlay,
-        uint8_t color)
+NatePixTable::Frame::Frame(Rect bounds, const PixMap& image, const PixMap& overlay, uint8_t color)
         : _bounds(bounds), _pix_map(bounds.width(), bounds.height()) {
     load_image(image);
     load_overlay(overlay, color);
-    build(id, frame);
 }
 
-NatePixTable::Frame::Frame(Rect bounds, const PixMap& image, int16_t id, int frame)
+NatePixTable::Frame::Frame(Rect bounds, const PixMap& image)
         : _bounds(bounds), _pix_map(bounds.width(), bounds.height()) {
     load_image(image);
-    build(id, frame);
 }
 
+NatePixTable::Frame::Frame(Rect bounds, ArrayPixMap&& pix_map)
+        : _bounds(bounds), _pix_map(std::move(pix_map)) {}
+
 NatePixTable::Frame::~Frame() {}
 
 void NatePixTable::Frame::load_image(const PixMap& pix) { _pix_map.copy(pix); }
 
 void NatePixTable::Frame::load_overlay(const PixMap& pix, uint8_t color) {
-    for (auto x : range(width())) {
-        for (auto y : range(height())) {
-            RgbColor over  = pix.get(x, y);
-            uint8_t  value = over.red;
-            uint8_t  frac  = over.alpha;
-            over           = RgbColor::tint(color, value);
-            RgbColor under = _pix_map.get(x, y);
-            RgbColor composite;
-            composite.red   = ((over.red * frac) + (under.red * (255 - frac))) / 255;
-            composite.green = ((over.green * frac) + (under.green * (255 - frac))) / 255;
-            composite.blue  = ((over.blue * frac) + (under.blue * (255 - frac))) / 255;
-            composite.alpha = under.alpha;
-            _pix_map.set(x, y, composite);
-        }
+    const PixelKernels& k = pixel_kernels();
+    for (auto y : range(height())) {
+        k.tint(_pix_map.mutable_row(y), pix.row(y), width(), color);
     }
 }
 
@@ -152,7 +297,8 @@ const PixMap&  NatePixTable::Frame::pix_map() const { return _pix_map; }
 const Texture& NatePixTable::Frame::texture() const { return _texture; }
 
 void NatePixTable::Frame::build(int16_t id, int frame) {
-    _texture = sys.video->texture(pn::format("/sprites/{0}.SMIV/{1}", id, frame), _pix_map);
+    _texture =
+            sys.video->atlas_texture(pn::format("/sprites/{0}.SMIV/{1}", id, frame), _pix_map);
 }
 
 }  // namespace antares
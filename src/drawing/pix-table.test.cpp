@@ -0,0 +1,137 @@
+// Copyright (C) 1997, 1999-2001, 2008 Nathan Lamont
+// Copyright (C) 2008-2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#include "drawing/pix-table.hpp"
+
+#include <dirent.h>
+#include <stdlib.h>
+#include <gmock/gmock.h>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "config/dirs.hpp"
+#include "config/preferences.hpp"
+#include "config/temp-dir.hpp"
+
+using std::string;
+using std::unique_ptr;
+using std::vector;
+
+namespace antares {
+namespace {
+
+// Sprites are cached in dirs().cache, which is read once per process, so every test shares one
+// cache directory.  Each test uses sprites (and tints) the others don't, so that it starts with
+// none of them cached.
+class PixTableTest : public testing::Test {
+  public:
+    static void SetUpTestCase() {
+        cache_dir = new TempDir("pix-table-test");
+        setenv("ANTARES_TEST_CACHE", cache_dir->path().copy().c_str(), 1);
+        ASSERT_EQ(
+                string(cache_dir->path().data(), cache_dir->path().size()),
+                string(dirs().cache.data(), dirs().cache.size()));
+    }
+
+    static void TearDownTestCase() { delete cache_dir; }
+
+    // The names of the files in the sprite cache.
+    static vector<string> cached() {
+        vector<string> names;
+        if (DIR* d = opendir(pn::format("{0}/sprites", cache_dir->path()).c_str())) {
+            while (struct dirent* e = readdir(d)) {
+                if (e->d_name[0] != '.') {
+                    names.push_back(e->d_name);
+                }
+            }
+            closedir(d);
+        }
+        return names;
+    }
+
+  protected:
+    NullPrefsDriver prefs;
+
+  private:
+    static TempDir* cache_dir;
+};
+
+TempDir* PixTableTest::cache_dir = nullptr;
+
+vector<RgbColor> pixels(const PixMap& pix) {
+    vector<RgbColor> result;
+    for (int y = 0; y < pix.size().height; ++y) {
+        result.insert(result.end(), pix.row(y), pix.row(y) + pix.size().width);
+    }
+    return result;
+}
+
+void expect_same_frames(const NatePixTable& expected, const NatePixTable& actual) {
+    ASSERT_EQ(expected.size(), actual.size());
+    for (int i = 0; i < expected.size(); ++i) {
+        const NatePixTable::Frame& e = expected.at(i);
+        const NatePixTable::Frame& a = actual.at(i);
+        ASSERT_EQ(e.width(), a.width()) << i;
+        ASSERT_EQ(e.height(), a.height()) << i;
+        EXPECT_EQ(e.center(), a.center()) << i;
+        EXPECT_THAT(pixels(a.pix_map()), testing::ContainerEq(pixels(e.pix_map()))) << i;
+    }
+}
+
+TEST_F(PixTableTest, CachedEqualsDecoded) {
+    const std::pair<int, uint8_t> sprites[] = {{501, 0}, {501, 3}, {550, 0}, {563, 12}};
+    for (const auto& s : sprites) {
+        // The first table is decoded, since nothing is cached yet, and caches its frames.  The
+        // second is loaded from the cache.
+        const size_t       before = cached().size();
+        const NatePixTable decoded(s.first, s.second);
+        ASSERT_EQ(before + 1, cached().size()) << s.first << " " << int(s.second);
+        const NatePixTable loaded(s.first, s.second);
+        EXPECT_EQ(before + 1, cached().size()) << s.first << " " << int(s.second);
+        expect_same_frames(decoded, loaded);
+    }
+}
+
+TEST_F(PixTableTest, ConcurrentWriters) {
+    // Several threads decode the same uncached sprite at once, and each writes it to the cache.
+    // The cache must end up with one whole copy, and no temporary files.
+    const int                        kThreads = 8;
+    vector<unique_ptr<NatePixTable>> decoded(kThreads);
+    vector<std::thread>              threads;
+    const size_t                     before = cached().size();
+    for (int i = 0; i < kThreads; ++i) {
+        threads.emplace_back([&decoded, i] { decoded[i].reset(new NatePixTable(510, 7)); });
+    }
+    for (std::thread& t : threads) {
+        t.join();
+    }
+    EXPECT_EQ(before + 1, cached().size());
+    for (const string& name : cached()) {
+        EXPECT_THAT(name, testing::Not(testing::EndsWith(".tmp")));
+    }
+
+    const NatePixTable loaded(510, 7);
+    for (const auto& table : decoded) {
+        expect_same_frames(*table, loaded);
+    }
+}
+
+}  // namespace
+}  // namespace antares
@@ -18,6 +18,7 @@
 
 #include "drawing/sprite-handling.hpp"
 
+#include <algorithm>
 #include <numeric>
 #include <sfz/sfz.hpp>
 
@@ -81,8 +82,10 @@ static draw_tiny_t draw_tiny_function(uint8_t id) {
 
 int32_t ANTARES_GLOBAL gAbsoluteScale = MIN_SCALE;
 
-void SpriteHandlingInit() {
-    g.sprites.reset(new Sprite[Sprite::size]);
+static ANTARES_GLOBAL bool gInterpolate = false;
+
+void SpriteHandlingInit(int32_t max_sprites) {
+    g.sprites.reset(max_sprites);
     ResetAllSprites();
 
     for (int i = 0; i < 4000; ++i) {
@@ -90,12 +93,9 @@ void SpriteHandlingInit() {
     }
 }
 
-Sprite* Sprite::get(int number) {
-    if ((0 <= number) && (number < size)) {
-        return &g.sprites[number];
-    }
-    return nullptr;
-}
+Sprite* Sprite::get(int number) { return g.sprites.get(number); }
+
+HandleList<Sprite> Sprite::all() { return HandleList<Sprite>(0, g.sprites.size()); }
 
 Sprite::Sprite()
         : table(NULL),
@@ -111,6 +111,32 @@ void ResetAllSprites() {
     for (auto sprite : Sprite::all()) {
         *sprite = Sprite();
     }
+    g.sprites.release_all();
+    for (auto& layer : g.sprite_layers) {
+        layer.clear();
+    }
+}
+
+static void add_to_layer(Handle<Sprite> sprite, int16_t layer) {
+    if ((layer < kFirstSpriteLayer) || (layer > kLastSpriteLayer)) {
+        return;
+    }
+    std::vector<int>& numbers = g.sprite_layers[layer];
+    auto              it = std::lower_bound(numbers.begin(), numbers.end(), sprite.number());
+    if ((it == numbers.end()) || (*it != sprite.number())) {
+        numbers.insert(it, sprite.number());
+    }
+}
+
+static void remove_from_layer(Handle<Sprite> sprite, int16_t layer) {
+    if ((layer < kFirstSpriteLayer) || (layer > kLastSpriteLayer)) {
+        return;
+    }
+    std::vector<int>& numbers = g.sprite_layers[layer];
+    auto              it = std::lower_bound(numbers.begin(), numbers.end(), sprite.number());
+    if ((it != numbers.end()) && (*it == sprite.number())) {
+        numbers.erase(it);
+    }
 }
 
 void Pix::reset() { pix.clear(); }
@@ -120,11 +146,21 @@ NatePixTable* Pix::add(int16_t resource_id) {
     if (result) {
         return result;
     }
+    return insert(resource_id, load(resource_id));
+}
 
+NatePixTable Pix::load(int16_t resource_id) {
     int16_t real_resource_id = resource_id & ~kSpriteTableColorIDMask;
     int16_t color            = (resource_id & kSpriteTableColorIDMask) >> kSpriteTableColorShift;
-    auto    it = pix.emplace(resource_id, NatePixTable(real_resource_id, color)).first;
-    return &it->second;
+    return NatePixTable(real_resource_id, color);
+}
+
+NatePixTable* Pix::insert(int16_t resource_id, NatePixTable table) {
+    auto it = pix.emplace(resource_id, std::move(table));
+    if (it.second) {
+        it.first->second.build();
+    }
+    return &it.first->second;
 }
 
 NatePixTable* Pix::get(int16_t resource_id) {
@@ -138,33 +174,46 @@ NatePixTable* Pix::get(int16_t resource_id) {
 Handle<Sprite> AddSprite(
         Point where, NatePixTable* table, int16_t resID, int16_t whichShape, int32_t scale,
         int32_t size, int16_t layer, const RgbColor& color) {
-    for (Handle<Sprite> sprite : Sprite::all()) {
-        if (sprite->table == NULL) {
-            sprite->where      = where;
-            sprite->table      = table;
-            sprite->resID      = resID;
-            sprite->whichShape = whichShape;
-            sprite->scale      = scale;
-            sprite->whichLayer = layer;
-            sprite->tinySize   = size;
-            sprite->tinyColor  = color;
-            sprite->draw_tiny  = draw_tiny_function(size);
-            sprite->killMe     = false;
-            sprite->style      = spriteNormal;
-            sprite->styleColor = RgbColor::white();
-            sprite->styleData  = 0;
-
-            return sprite;
-        }
+    // RemoveSprite() and ResetAllSprites() clear a sprite's table before releasing its slot, so a
+    // slot from the pool is never in use.
+    auto sprite = Handle<Sprite>(g.sprites.allocate());
+    if (!sprite.get()) {
+        return Sprite::none();
     }
 
-    return Sprite::none();
+    sprite->where      = where;
+    sprite->last_where = where;
+    sprite->table      = table;
+    sprite->resID      = resID;
+    sprite->whichShape = whichShape;
+    sprite->scale      = scale;
+    sprite->whichLayer = layer;
+    sprite->tinySize   = size;
+    sprite->tinyColor  = color;
+    sprite->draw_tiny  = draw_tiny_function(size);
+    sprite->killMe     = false;
+    sprite->style      = spriteNormal;
+    sprite->styleColor = RgbColor::white();
+    sprite->styleData  = 0;
+    add_to_layer(sprite, layer);
+
+    return sprite;
+}
+
+void SetSpriteLayer(Handle<Sprite> sprite, int16_t layer) {
+    if (sprite->whichLayer != layer) {
+        remove_from_layer(sprite, sprite->whichLayer);
+        sprite->whichLayer = layer;
+        add_to_layer(sprite, layer);
+    }
 }
 
 void RemoveSprite(Handle<Sprite> sprite) {
+    remove_from_layer(sprite, sprite->whichLayer);
     sprite->killMe = false;
     sprite->table  = NULL;
     sprite->resID  = -1;
+    g.sprites.release(sprite.number());
 }
 
 Fixed scale_by(Fixed value, int32_t scale) { return (value * scale) / SCALE_SCALE; }
@@ -182,45 +231,87 @@ Rect scale_sprite_rect(const NatePixTable::Frame& frame, Point where, int32_t sc
     return draw_rect;
 }
 
-void draw_sprites() {
+void set_draw_interpolation(bool on) { gInterpolate = on; }
+
+int32_t draw_progress(usecs since_tick) {
+    if (!gInterpolate) {
+        return 256;
+    }
+    const int64_t progress = (since_tick.count() * 256) / usecs(kMinorTick).count();
+    return std::max<int64_t>(0, std::min<int64_t>(256, progress));
+}
+
+Point interpolate(Point last, Point now, int32_t progress) {
+    const int32_t dh = now.h - last.h;
+    const int32_t dv = now.v - last.v;
+    if ((progress >= 256) || (abs(dh) > kMaxInterpolatedMove) ||
+        (abs(dv) > kMaxInterpolatedMove)) {
+        return now;
+    }
+    return Point(last.h + ((dh * progress) / 256), last.v + ((dv * progress) / 256));
+}
+
+void RememberSpritePositions() {
+    for (auto sprite : Sprite::all()) {
+        sprite->last_where = sprite->where;
+    }
+}
+
+// Sprites are only drawn if some part of them lands on the play screen; anything else would be
+// covered by the instrument panels.  Color sprites still call Randomize() when culled, so that
+// the global random sequence doesn't depend on what's on screen.
+void draw_sprites(int32_t progress) {
+    const Rect bounds = play_screen();
     if (gAbsoluteScale >= kBlipThreshhold) {
         for (int layer : range<int>(kFirstSpriteLayer, kLastSpriteLayer + 1)) {
-            for (auto aSprite : Sprite::all()) {
-                if ((aSprite->table != NULL) && !aSprite->killMe &&
-                    (aSprite->whichLayer == layer)) {
-                    int32_t trueScale = evil_scale_by(aSprite->scale, gAbsoluteScale);
-                    const NatePixTable::Frame& frame = aSprite->table->at(aSprite->whichShape);
-
-                    const int32_t map_width  = evil_scale_by(frame.width(), trueScale);
-                    const int32_t map_height = evil_scale_by(frame.height(), trueScale);
-                    const int32_t scaled_h   = evil_scale_by(frame.center().h, trueScale);
-                    const int32_t scaled_v   = evil_scale_by(frame.center().v, trueScale);
-                    const Point   scaled_center(scaled_h, scaled_v);
-
-                    Rect draw_rect(0, 0, map_width, map_height);
-                    draw_rect.offset(aSprite->where.h - scaled_h, aSprite->where.v - scaled_v);
-
-                    switch (aSprite->style) {
-                        case spriteNormal: frame.texture().draw(draw_rect); break;
-
-                        case spriteColor:
-                            Randomize(63);
+            for (int number : g.sprite_layers[layer]) {
+                const Sprite* aSprite = Sprite::get(number);
+                if ((aSprite->table == NULL) || aSprite->killMe) {
+                    continue;
+                }
+                int32_t trueScale = evil_scale_by(aSprite->scale, gAbsoluteScale);
+                const NatePixTable::Frame& frame = aSprite->table->at(aSprite->whichShape);
+
+                const int32_t map_width  = evil_scale_by(frame.width(), trueScale);
+                const int32_t map_height = evil_scale_by(frame.height(), trueScale);
+                const int32_t scaled_h   = evil_scale_by(frame.center().h, trueScale);
+                const int32_t scaled_v   = evil_scale_by(frame.center().v, trueScale);
+
+                Rect draw_rect(0, 0, map_width, map_height);
+                const Point where = interpolate(aSprite->last_where, aSprite->where, progress);
+                draw_rect.offset(where.h - scaled_h, where.v - scaled_v);
+                const bool visible = draw_rect.intersects(bounds);
+
+                switch (aSprite->style) {
+                    case spriteNormal:
+                        if (visible) {
+                            frame.texture().draw(draw_rect);
+                        }
+                        break;
+
+                    case spriteColor:
+                        Randomize(63);
+                        if (visible) {
                             frame.texture().draw_static(
                                     draw_rect, aSprite->styleColor, aSprite->styleData);
-                            break;
-                    }
+                        }
+                        break;
                 }
             }
         }
     } else {
         for (int layer : range<int>(kFirstSpriteLayer, kLastSpriteLayer + 1)) {
-            for (auto aSprite : Sprite::all()) {
-                int tinySize = aSprite->tinySize & kBlipSizeMask;
+            for (int number : g.sprite_layers[layer]) {
+                const Sprite* aSprite  = Sprite::get(number);
+                int           tinySize = aSprite->tinySize & kBlipSizeMask;
                 if ((aSprite->table != NULL) && !aSprite->killMe && tinySize &&
-                    (aSprite->draw_tiny != NULL) && (aSprite->whichLayer == layer)) {
+                    (aSprite->draw_tiny != NULL)) {
                     Rect tiny_rect(-tinySize, -tinySize, tinySize, tinySize);
-                    tiny_rect.offset(aSprite->where.h, aSprite->where.v);
-                    aSprite->draw_tiny(tiny_rect, aSprite->tinyColor);
+                    const Point where = interpolate(aSprite->last_where, aSprite->where, progress);
+                    tiny_rect.offset(where.h, where.v);
+                    if (tiny_rect.intersects(bounds)) {
+                        aSprite->draw_tiny(tiny_rect, aSprite->tinyColor);
+                    }
                 }
             }
         }
@@ -211,8 +211,6 @@ void StyledText::set_interface_text(pn::string_view text) {
         }
     }
     _chars.push_back(StyledChar('\n', LINE_BREAK, f, b));
-
-    wrap_to(std::numeric_limits<int>::max(), 0, 0);
 }
 
 void StyledText::wrap_to(int width, int side_margin, int line_spacing) {
@@ -226,11 +224,12 @@ void StyledText::wrap_to(int width, int side_margin, int line_spacing) {
     int wrap_distance = width - side_margin;
 
     for (size_t i = 0; i < _chars.size(); ++i) {
-        _chars[i].h = h;
-        _chars[i].v = v;
+        _chars[i].glyph = &_font->glyph(_chars[i].character);
+        _chars[i].h     = h;
+        _chars[i].v     = v;
         switch (_chars[i].special) {
             case NONE:
-                h += _font->char_width(_chars[i].character);
+                h += _chars[i].glyph->bounds.width();
                 if (h >= wrap_distance) {
                     v += _font->height + _line_spacing;
                     h = move_word_down(i, v);
@@ -248,7 +247,7 @@ void StyledText::wrap_to(int width, int side_margin, int line_spacing) {
                 v += _font->height + _line_spacing;
                 break;
 
-            case WORD_BREAK: h += _font->char_width(_chars[i].character); break;
+            case WORD_BREAK: h += _chars[i].glyph->bounds.width(); break;
 
             case PICTURE: {
                 inlinePictType* pict = &_inline_picts[_chars[i].character.value()];
@@ -291,7 +290,6 @@ void StyledText::draw(const Rect& bounds) const { draw_range(bounds, 0, _chars.s
 
 void StyledText::draw_range(const Rect& bounds, int begin, int end) const {
     const int line_height = _font->height + _line_spacing;
-    const int char_adjust = _font->ascent + _line_spacing;
     {
         Rects rects;
         for (size_t i = begin; i < end; ++i) {
@@ -303,7 +301,7 @@ void StyledText::draw_range(const Rect& bounds, int begin, int end) const {
                 case WORD_BREAK:
                     corner.offset(ch.h, ch.v);
                     if (ch.back_color != RgbColor::black()) {
-                        Rect char_rect(0, 0, _font->char_width(ch.character), line_height);
+                        Rect char_rect(0, 0, ch.glyph->bounds.width(), line_height);
                         char_rect.offset(corner.h, corner.v);
                         rects.fill(char_rect, ch.back_color);
                     }
@@ -337,9 +335,9 @@ void StyledText::draw_range(const Rect& bounds, int begin, int end) const {
         for (size_t i = begin; i < end; ++i) {
             const StyledChar& ch = _chars[i];
             if (ch.special == NONE) {
-                _font->draw(
-                        quads, Point(bounds.left + ch.h, bounds.top + ch.v + char_adjust),
-                        ch.character, ch.fore_color);
+                _font->draw_glyph(
+                        quads, Point(bounds.left + ch.h, bounds.top + ch.v + _line_spacing),
+                        *ch.glyph, ch.fore_color);
             }
         }
     }
@@ -393,7 +391,7 @@ int StyledText::move_word_down(int index, int v) {
                 for (int j = i + 1; j <= index; ++j) {
                     _chars[j].h = h;
                     _chars[j].v = v;
-                    h += _font->char_width(_chars[j].character);
+                    h += _chars[j].glyph->bounds.width();
                 }
                 return h;
             }
@@ -411,6 +409,7 @@ StyledText::StyledChar::StyledChar(
           special(special),
           fore_color(fore_color),
           back_color(back_color),
+          glyph(nullptr),
           h(0),
           v(0) {}
 
@@ -28,6 +28,7 @@
 #include "data/resource.hpp"
 #include "drawing/color.hpp"
 #include "game/globals.hpp"
+#include "game/sys.hpp"
 #include "lang/defines.hpp"
 #include "video/driver.hpp"
 
@@ -77,25 +78,38 @@ Font::Font(pn::string_view name) {
 
     Picture glyph_table(image, true);
     recolor(glyph_table);
-    texture = glyph_table.texture();
+    texture = sys.video->atlas_texture(pn::format("/{0}", glyph_table.path()), glyph_table);
     _scale  = glyph_table.scale();
 
     for (pn::key_value_cref kv : glyphs) {
-        pn::string_view glyph    = kv.key();
-        pn::map_cref    rect_map = kv.value().as_map();
-
-        _glyphs[*glyph.begin()] =
-                Rect(rect_map.get("left").as_int(), rect_map.get("top").as_int(),
-                     rect_map.get("right").as_int(), rect_map.get("bottom").as_int());
+        pn::rune     rune     = *kv.key().begin();
+        pn::map_cref rect_map = kv.value().as_map();
+
+        Glyph glyph;
+        glyph.bounds = Rect(
+                rect_map.get("left").as_int(), rect_map.get("top").as_int(),
+                rect_map.get("right").as_int(), rect_map.get("bottom").as_int());
+        glyph.texture =
+                Rect(glyph.bounds.left * _scale, glyph.bounds.top * _scale,
+                     glyph.bounds.right * _scale, glyph.bounds.bottom * _scale);
+        if (rune.value() < kDenseGlyphs) {
+            _dense_glyphs[rune.value()] = glyph;
+        } else {
+            _other_glyphs[rune] = glyph;
+        }
     }
 }
 
 Font::~Font() {}
 
-Rect Font::glyph_rect(pn::rune rune) const {
-    auto it = _glyphs.find(rune);
-    if (it == _glyphs.end()) {
-        return Rect();
+const Font::Glyph& Font::glyph(pn::rune rune) const {
+    static const Glyph kEmpty = {};
+    if (rune.value() < kDenseGlyphs) {
+        return _dense_glyphs[rune.value()];
+    }
+    auto it = _other_glyphs.find(rune);
+    if (it == _other_glyphs.end()) {
+        return kEmpty;
     }
     return it->second;
 }
@@ -107,16 +121,20 @@ void Font::draw(Point cursor, pn::string_view string, RgbColor color) const {
 void Font::draw(const Quads& quads, Point cursor, pn::string_view string, RgbColor color) const {
     cursor.offset(0, -ascent);
     for (pn::rune rune : string) {
-        auto glyph = glyph_rect(rune);
-        Rect scaled(
-                glyph.left * _scale, glyph.top * _scale, glyph.right * _scale,
-                glyph.bottom * _scale);
-        quads.draw(Rect(cursor, glyph.size()), scaled, color);
-        cursor.offset(glyph.width(), 0);
+        const Glyph& g = glyph(rune);
+        draw_glyph(quads, cursor, g, color);
+        cursor.offset(g.bounds.width(), 0);
+    }
+}
+
+void Font::draw_glyph(const Quads& quads, Point at, const Glyph& glyph, RgbColor color) const {
+    if (glyph.bounds.empty()) {
+        return;  // e.g. space.
     }
+    quads.draw(Rect(at, glyph.bounds.size()), glyph.texture, color);
 }
 
-uint8_t Font::char_width(pn::rune mchar) const { return glyph_rect(mchar).width(); }
+uint8_t Font::char_width(pn::rune mchar) const { return glyph(mchar).bounds.width(); }
 
 int32_t Font::string_width(pn::string_view s) const {
     int32_t sum = 0;
@@ -18,7 +18,9 @@
 
 #include "game/action.hpp"
 
+#include <algorithm>
 #include <set>
+#include <vector>
 #include <sfz/sfz.hpp>
 
 #include "data/base-object.hpp"
@@ -40,6 +42,7 @@
 #include "game/player-ship.hpp"
 #include "game/space-object.hpp"
 #include "game/starfield.hpp"
+#include "game/sync-trace.hpp"
 #include "game/sys.hpp"
 #include "game/vector.hpp"
 #include "lang/defines.hpp"
@@ -52,16 +55,17 @@
 
 using sfz::range;
 using std::set;
-using std::unique_ptr;
 
 namespace antares {
 
+// The most actions that can be waiting at once.  Actions queued past this are dropped, as they
+// always have been; replays depend on it.
 const size_t kActionQueueLength = 120;
 
 struct actionQueueType {
     HandleList<Action>  actionRef;
-    ticks               scheduledTime;
-    actionQueueType*    nextActionQueue;
+    ticks               scheduledTime;  // on gActionQueueTime
+    int64_t             sequence;       // order queued; later runs first among equal times
     Handle<SpaceObject> subjectObject;
     int32_t             subjectObjectNum;
     int32_t             subjectObjectID;
@@ -71,9 +75,15 @@ struct actionQueueType {
     Point               offset;
 };
 
-static ANTARES_GLOBAL actionQueueType* gFirstActionQueue = NULL;
+// Pending actions, as a binary heap with the next action to run at the front.  Actions due at
+// the same time run in the reverse of the order they were queued, which is what the sorted list
+// this replaces did.
+static ANTARES_GLOBAL std::vector<actionQueueType> gActionQueue;
 
-static ANTARES_GLOBAL unique_ptr<actionQueueType[]> gActionQueueData;
+// Advances by kMajorTick on each execute_action_queue().  Actions are scheduled against it, so
+// that pending actions don't need to count down one by one.
+static ANTARES_GLOBAL ticks   gActionQueueTime     = ticks(0);
+static ANTARES_GLOBAL int64_t gActionQueueSequence = 0;
 
 #ifdef DATA_COVERAGE
 ANTARES_GLOBAL set<int32_t> covered_actions;
@@ -787,102 +797,145 @@ void exec(
     execute_actions(actions, sObject, dObject, offset, true);
 }
 
-void reset_action_queue() {
-    gActionQueueData.reset(new actionQueueType[kActionQueueLength]);
+// Heap order for gActionQueue: true if `x` runs after `y`.
+static bool runs_after(const actionQueueType& x, const actionQueueType& y) {
+    if (x.scheduledTime != y.scheduledTime) {
+        return x.scheduledTime > y.scheduledTime;
+    }
+    return x.sequence < y.sequence;
+}
 
-    gFirstActionQueue = NULL;
+// Returns the pending actions, in the order they will run.
+static std::vector<actionQueueType> sorted_action_queue() {
+    std::vector<actionQueueType> queue = gActionQueue;
+    std::sort(queue.begin(), queue.end(), [](const actionQueueType& x, const actionQueueType& y) {
+        return runs_after(y, x);
+    });
+    return queue;
+}
 
-    actionQueueType* action = gActionQueueData.get();
-    for (int32_t i = 0; i < kActionQueueLength; i++) {
-        (action++)->actionRef = {-1, -1};
-    }
+void reset_action_queue() {
+    gActionQueue.clear();
+    gActionQueue.reserve(kActionQueueLength);
+    gActionQueueTime     = ticks(0);
+    gActionQueueSequence = 0;
 }
 
 static void queue_action(
         HandleList<Action> actions, ticks delayTime, Handle<SpaceObject> subjectObject,
         Handle<SpaceObject> directObject, Point* offset) {
-    int32_t          queueNumber = 0;
-    actionQueueType* actionQueue = gActionQueueData.get();
-    while (actionQueue->actionRef.size() && (queueNumber < kActionQueueLength)) {
-        actionQueue++;
-        queueNumber++;
-    }
-
-    if (queueNumber == kActionQueueLength) {
+    if (gActionQueue.size() >= kActionQueueLength) {
         return;
     }
-    actionQueue->actionRef     = actions;
-    actionQueue->scheduledTime = delayTime;
+
+    actionQueueType actionQueue;
+    actionQueue.actionRef     = actions;
+    actionQueue.scheduledTime = gActionQueueTime + delayTime;
+    actionQueue.sequence      = gActionQueueSequence++;
 
     if (offset) {
-        actionQueue->offset = *offset;
+        actionQueue.offset = *offset;
     } else {
-        actionQueue->offset = Point{0, 0};
+        actionQueue.offset = Point{0, 0};
     }
 
-    actionQueue->subjectObject = subjectObject;
+    actionQueue.subjectObject = subjectObject;
     if (subjectObject.get()) {
-        actionQueue->subjectObjectNum = subjectObject->number();
-        actionQueue->subjectObjectID  = subjectObject->id;
+        actionQueue.subjectObjectNum = subjectObject->number();
+        actionQueue.subjectObjectID  = subjectObject->id;
     } else {
-        actionQueue->subjectObjectNum = -1;
-        actionQueue->subjectObjectID  = -1;
+        actionQueue.subjectObjectNum = -1;
+        actionQueue.subjectObjectID  = -1;
     }
 
-    actionQueue->directObject = directObject;
+    actionQueue.directObject = directObject;
     if (directObject.get()) {
-        actionQueue->directObjectNum = directObject->number();
-        actionQueue->directObjectID  = directObject->id;
+        actionQueue.directObjectNum = directObject->number();
+        actionQueue.directObjectID  = directObject->id;
     } else {
-        actionQueue->directObjectNum = -1;
-        actionQueue->directObjectID  = -1;
+        actionQueue.directObjectNum = -1;
+        actionQueue.directObjectID  = -1;
     }
 
-    actionQueueType* previousQueue = NULL;
-    actionQueueType* nextQueue     = gFirstActionQueue;
-    while (nextQueue && (nextQueue->scheduledTime < delayTime)) {
-        previousQueue = nextQueue;
-        nextQueue     = nextQueue->nextActionQueue;
-    }
-    if (previousQueue) {
-        actionQueue->nextActionQueue = previousQueue->nextActionQueue;
-
-        previousQueue->nextActionQueue = actionQueue;
-    } else {
-        actionQueue->nextActionQueue = gFirstActionQueue;
-        gFirstActionQueue            = actionQueue;
-    }
+    gActionQueue.push_back(actionQueue);
+    std::push_heap(gActionQueue.begin(), gActionQueue.end(), runs_after);
 }
 
 void execute_action_queue() {
-    for (int32_t i = 0; i < kActionQueueLength; i++) {
-        auto actionQueue = &gActionQueueData[i];
-        if (actionQueue->actionRef.size()) {
-            actionQueue->scheduledTime -= kMajorTick;
-        }
-    }
+    gActionQueueTime += kMajorTick;
+
+    while (!gActionQueue.empty() && (gActionQueue.front().scheduledTime <= gActionQueueTime)) {
+        // The action stays at the front while it runs: anything it queues has a positive delay,
+        // so it runs later.  It also still counts against kActionQueueLength, as it used to.
+        actionQueueType actionQueue = gActionQueue.front();
 
-    while (gFirstActionQueue && gFirstActionQueue->actionRef.size() &&
-           (gFirstActionQueue->scheduledTime <= ticks(0))) {
         int32_t subjectid = -1;
-        if (gFirstActionQueue->subjectObject.get() && gFirstActionQueue->subjectObject->active) {
-            subjectid = gFirstActionQueue->subjectObject->id;
+        if (actionQueue.subjectObject.get() && actionQueue.subjectObject->active) {
+            subjectid = actionQueue.subjectObject->id;
         }
 
         int32_t directid = -1;
-        if (gFirstActionQueue->directObject.get() && gFirstActionQueue->directObject->active) {
-            directid = gFirstActionQueue->directObject->id;
+        if (actionQueue.directObject.get() && actionQueue.directObject->active) {
+            directid = actionQueue.directObject->id;
         }
-        if ((subjectid == gFirstActionQueue->subjectObjectID) &&
-            (directid == gFirstActionQueue->directObjectID)) {
+        if ((subjectid == actionQueue.subjectObjectID) &&
+            (directid == actionQueue.directObjectID)) {
             execute_actions(
-                    gFirstActionQueue->actionRef, gFirstActionQueue->subjectObject,
-                    gFirstActionQueue->directObject, &gFirstActionQueue->offset, false);
+                    actionQueue.actionRef, actionQueue.subjectObject, actionQueue.directObject,
+                    &actionQueue.offset, false);
         }
 
-        gFirstActionQueue->actionRef = {-1, -1};
-        gFirstActionQueue            = gFirstActionQueue->nextActionQueue;
-    }
+        std::pop_heap(gActionQueue.begin(), gActionQueue.end(), runs_after);
+        gActionQueue.pop_back();
+    }
+}
+
+void hash_action_queue(SyncHash* hash) {
+    for (const auto& q : sorted_action_queue()) {
+        hash->add((*q.actionRef.begin()).number());
+        hash->add(q.actionRef.size());
+        hash->add((q.scheduledTime - gActionQueueTime).count());
+        hash->add(q.subjectObjectNum);
+        hash->add(q.subjectObjectID);
+        hash->add(q.directObjectNum);
+        hash->add(q.directObjectID);
+        hash->add(q.offset.h);
+        hash->add(q.offset.v);
+    }
+}
+
+std::vector<QueuedAction> save_action_queue() {
+    std::vector<QueuedAction> queue;
+    for (const auto& q : sorted_action_queue()) {
+        queue.push_back(QueuedAction{q.actionRef, q.scheduledTime - gActionQueueTime,
+                                     q.subjectObject, q.subjectObjectNum, q.subjectObjectID,
+                                     q.directObject, q.directObjectNum, q.directObjectID,
+                                     q.offset});
+    }
+    return queue;
+}
+
+// The restored actions are numbered so that they run in the order given, and any queued after
+// them run first among actions due at the same time.
+void restore_action_queue(const std::vector<QueuedAction>& queue) {
+    reset_action_queue();
+    for (int32_t i = 0; (i < queue.size()) && (i < kActionQueueLength); i++) {
+        const QueuedAction& a = queue[i];
+        actionQueueType     q;
+        q.actionRef        = a.actions;
+        q.scheduledTime    = a.delay;
+        q.sequence         = queue.size() - 1 - i;
+        q.subjectObject    = a.subject;
+        q.subjectObjectNum = a.subject_num;
+        q.subjectObjectID  = a.subject_id;
+        q.directObject     = a.direct;
+        q.directObjectNum  = a.direct_num;
+        q.directObjectID   = a.direct_id;
+        q.offset           = a.offset;
+        gActionQueue.push_back(q);
+    }
+    std::make_heap(gActionQueue.begin(), gActionQueue.end(), runs_after);
+    gActionQueueSequence = queue.size();
 }
 
 }  // namespace antares
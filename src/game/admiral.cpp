@@ -18,6 +18,8 @@
 
 #include "game/admiral.hpp"
 
+#include <string.h>
+
 #include "data/base-object.hpp"
 #include "data/string-list.hpp"
 #include "game/cheat.hpp"
@@ -59,6 +61,21 @@ void Admiral::reset() {
     }
 }
 
+void Admiral::copy_all(const GlobalState& from, GlobalState* to) {
+    if (!to->admirals) {
+        to->admirals.reset(new Admiral[kMaxPlayerNum]);
+    }
+    if (!to->destinations) {
+        to->destinations.reset(new Destination[kMaxDestObject]);
+    }
+    for (int i = 0; i < kMaxPlayerNum; ++i) {
+        to->admirals[i] = from.admirals[i].copy();
+    }
+    for (int i = 0; i < kMaxDestObject; ++i) {
+        to->destinations[i] = from.destinations[i].copy();
+    }
+}
+
 void ResetAllDestObjectData() {
     for (auto d : Destination::all()) {
         d->whichObject = SpaceObject::none();
@@ -91,6 +108,52 @@ bool Destination::can_build() const {
     return false;
 }
 
+Destination Destination::copy() const {
+    Destination copy;
+    copy.whichObject = whichObject;
+    memcpy(copy.canBuildType, canBuildType, sizeof(canBuildType));
+    memcpy(copy.occupied, occupied, sizeof(occupied));
+    copy.earn               = earn;
+    copy.buildTime          = buildTime;
+    copy.totalBuildTime     = totalBuildTime;
+    copy.buildObjectBaseNum = buildObjectBaseNum;
+    copy.name               = name.copy();
+    return copy;
+}
+
+Admiral Admiral::copy() const {
+    Admiral copy;
+    copy._attributes          = _attributes;
+    copy._has_destination     = _has_destination;
+    copy._destinationObject   = _destinationObject;
+    copy._destinationObjectID = _destinationObjectID;
+    copy._flagship            = _flagship;
+    copy._flagshipID          = _flagshipID;
+    copy._considerShip        = _considerShip;
+    copy._considerShipID      = _considerShipID;
+    copy._considerDestination = _considerDestination;
+    copy._buildAtObject       = _buildAtObject;
+    copy._race                = _race;
+    copy._cash                = _cash;
+    copy._saveGoal            = _saveGoal;
+    copy._earning_power       = _earning_power;
+    copy._kills               = _kills;
+    copy._losses              = _losses;
+    copy._shipsLeft           = _shipsLeft;
+    memcpy(copy._score, _score, sizeof(_score));
+    copy._blitzkrieg             = _blitzkrieg;
+    copy._lastFreeEscortStrength = _lastFreeEscortStrength;
+    copy._thisFreeEscortStrength = _thisFreeEscortStrength;
+    std::copy(_canBuildType, _canBuildType + kMaxNumAdmiralCanBuild, copy._canBuildType);
+    copy._totalBuildChance = _totalBuildChance;
+    copy._hopeToBuild      = _hopeToBuild;
+    copy._color            = _color;
+    copy._active           = _active;
+    copy._cheats           = _cheats;
+    copy._name             = _name.copy();
+    return copy;
+}
+
 Admiral* Admiral::get(int i) {
     if ((0 <= i) && (i < kMaxPlayerNum)) {
         return &g.admirals[i];
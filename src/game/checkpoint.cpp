@@ -0,0 +1,114 @@
+// Copyright (C) 1997, 1999-2001, 2008 Nathan Lamont
+// Copyright (C) 2008-2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#include "game/checkpoint.hpp"
+
+#include "data/plugin.hpp"
+#include "drawing/sprite-handling.hpp"
+#include "game/admiral.hpp"
+#include "game/instruments.hpp"
+#include "game/labels.hpp"
+#include "game/minicomputer.hpp"
+#include "game/motion.hpp"
+#include "game/space-object.hpp"
+#include "game/vector.hpp"
+#include "lang/defines.hpp"
+
+namespace antares {
+
+static ANTARES_GLOBAL CheckpointLog* gCheckpointLog = nullptr;
+
+Checkpoint::Checkpoint(const PlayerShip& player_ship) {
+    copy_globals(g, &_g);
+    _action_queue = save_action_queue();
+    for (const auto& condition : plug.conditions) {
+        _condition_flags.push_back(condition.flags);
+    }
+    _scale_history  = save_scale_history();
+    _absolute_scale = gAbsoluteScale;
+    _global_corner  = gGlobalCorner;
+    Messages::save(&_messages);
+    player_ship.save(&_player_ship);
+
+    for (int i = 0; i < kHotKeyNum; ++i) {
+        _hot_keys[i] = globals()->hotKey[i];
+    }
+    _last_selected    = globals()->lastSelectedObject;
+    _last_selected_id = globals()->lastSelectedObjectID;
+    _next_klaxon      = globals()->next_klaxon;
+}
+
+Checkpoint::~Checkpoint() {}
+
+void Checkpoint::restore(PlayerShip* player_ship) const {
+    copy_globals(_g, &g);
+    restore_action_queue(_action_queue);
+    for (int i = 0; i < _condition_flags.size(); ++i) {
+        plug.conditions[i].flags = _condition_flags[i];
+    }
+    restore_scale_history(_scale_history);
+    gAbsoluteScale = _absolute_scale;
+    gGlobalCorner  = _global_corner;
+    Messages::restore(_messages);
+    player_ship->restore(_player_ship);
+
+    for (int i = 0; i < kHotKeyNum; ++i) {
+        globals()->hotKey[i] = _hot_keys[i];
+    }
+    globals()->lastSelectedObject   = _last_selected;
+    globals()->lastSelectedObjectID = _last_selected_id;
+    globals()->next_klaxon          = _next_klaxon;
+}
+
+CheckpointLog::CheckpointLog(ticks interval) : _interval(interval) {}
+
+CheckpointLog::~CheckpointLog() {}
+
+void CheckpointLog::tick(PlayerShip* player_ship) {
+    game_ticks last = latest(g.time);
+    if ((last == game_ticks::min()) || ((g.time - last) >= _interval)) {
+        _checkpoints[g.time].reset(new Checkpoint(*player_ship));
+    }
+}
+
+bool CheckpointLog::restore(game_ticks at, PlayerShip* player_ship) {
+    game_ticks time = latest(at);
+    if (time == game_ticks::min()) {
+        return false;
+    }
+    _checkpoints[time]->restore(player_ship);
+    return true;
+}
+
+game_ticks CheckpointLog::latest(game_ticks at) const {
+    auto it = _checkpoints.upper_bound(at);
+    if (it == _checkpoints.begin()) {
+        return game_ticks::min();
+    }
+    return (--it)->first;
+}
+
+void set_checkpoint_log(CheckpointLog* log) { gCheckpointLog = log; }
+
+void checkpoint_tick(PlayerShip* player_ship) {
+    if (gCheckpointLog) {
+        gCheckpointLog->tick(player_ship);
+    }
+}
+
+}  // namespace antares
@@ -52,6 +52,52 @@ void init_globals() {
     g.farthest = Handle<SpaceObject>(0);
 }
 
+void copy_globals(const GlobalState& from, GlobalState* to) {
+    to->sync   = from.sync;
+    to->time   = from.time;
+    to->random = from.random;
+    to->level  = from.level;
+    to->angle  = from.angle;
+
+    Admiral::copy_all(from, to);
+    to->admiral = from.admiral;
+
+    to->objects.assign(from.objects);
+    to->ship = from.ship;
+    to->root = from.root;
+
+    Vectors::copy_all(from, to);
+    to->sprites.assign(from.sprites);
+    for (int i = 0; i <= kLastSpriteLayer; ++i) {
+        to->sprite_layers[i] = from.sprite_layers[i];
+    }
+
+    to->game_over    = from.game_over;
+    to->game_over_at = from.game_over_at;
+    to->victor       = from.victor;
+    to->next_level   = from.next_level;
+    to->victory_text = from.victory_text;
+
+    to->radar_count = from.radar_count;
+    to->radar_on    = from.radar_on;
+
+    Label::copy_all(from, to);
+    to->control_label = from.control_label;
+    to->target_label  = from.target_label;
+    to->message_label = from.message_label;
+    to->status_label  = from.status_label;
+    to->send_label    = from.send_label;
+
+    to->bottom_border = from.bottom_border;
+    to->key_mask      = from.key_mask;
+
+    MiniScreenCopy(from, to);
+
+    to->zoom     = from.zoom;
+    to->closest  = from.closest;
+    to->farthest = from.farthest;
+}
+
 aresGlobalType::aresGlobalType() {}
 
 aresGlobalType::~aresGlobalType() {}
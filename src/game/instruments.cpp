@@ -18,6 +18,7 @@
 
 #include "game/instruments.hpp"
 
+#include <stdlib.h>
 #include <algorithm>
 #include <sfz/sfz.hpp>
 
@@ -25,6 +26,7 @@
 #include "data/picture.hpp"
 #include "drawing/color.hpp"
 #include "drawing/shapes.hpp"
+#include "drawing/sprite-handling.hpp"
 #include "game/admiral.hpp"
 #include "game/cursor.hpp"
 #include "game/globals.hpp"
@@ -127,9 +129,11 @@ struct barIndicatorType {
 };
 
 static ANTARES_GLOBAL coordPointType gLastGlobalCorner;
+static ANTARES_GLOBAL coordPointType gPreviousGlobalCorner;  // as of the tick before
 static ANTARES_GLOBAL unique_ptr<int32_t[]> gScaleList;
 static ANTARES_GLOBAL int32_t gWhichScaleNum;
 static ANTARES_GLOBAL int32_t gLastScale;
+static ANTARES_GLOBAL int32_t gPreviousScale;  // as of the tick before
 static ANTARES_GLOBAL bool    should_draw_sector_lines = false;
 static ANTARES_GLOBAL Rect view_range;
 static ANTARES_GLOBAL barIndicatorType gBarIndicator[kBarIndicatorNum];
@@ -181,9 +185,10 @@ void ResetInstruments() {
     Point*   lp;
 
     g.radar_count = ticks(0);
-    gLastScale = gAbsoluteScale = SCALE_SCALE;
-    gWhichScaleNum              = 0;
+    gLastScale = gPreviousScale = gAbsoluteScale = SCALE_SCALE;
+    gWhichScaleNum                               = 0;
     gLastGlobalCorner.h = gLastGlobalCorner.v = 0;
+    gPreviousGlobalCorner                     = gLastGlobalCorner;
     l                                         = gScaleList.get();
     for (i = 0; i < kScaleListNum; i++) {
         *l = SCALE_SCALE;
@@ -341,6 +346,19 @@ void UpdateRadar(ticks unitsDone) {
     gAbsoluteScale = absolute_scale;
 }
 
+std::vector<int32_t> save_scale_history() {
+    std::vector<int32_t> scales;
+    for (int i = 0; i < kScaleListNum; i++) {
+        scales.push_back(gScaleList[(gWhichScaleNum + i) % kScaleListNum]);
+    }
+    return scales;
+}
+
+void restore_scale_history(const std::vector<int32_t>& scales) {
+    std::copy(scales.begin(), scales.end(), gScaleList.get());
+    gWhichScaleNum = 0;
+}
+
 void draw_radar() {
     Rect bounds(kRadarLeft, kRadarTop, kRadarRight, kRadarBottom);
     bounds.offset(0, instrument_top());
@@ -564,12 +582,25 @@ void update_site(bool replay) {
     }
 }
 
-void draw_site(const PlayerShip& player) {
+static void draw_triangle(Lines& lines, const SiteData& site, Point shift) {
+    Point a = site.a, b = site.b, c = site.c;
+    a.offset(shift.h, shift.v);
+    b.offset(shift.h, shift.v);
+    c.offset(shift.h, shift.v);
+    lines.draw(a, b, site.light);
+    lines.draw(a, c, site.light);
+    lines.draw(b, c, site.dark);
+}
+
+void draw_site(const PlayerShip& player, int32_t progress) {
     if (site.should_draw) {
+        // The site follows the player's ship, so it moves with the ship's sprite.
+        const Point& where = g.ship->sprite->where;
+        const Point  at    = interpolate(g.ship->sprite->last_where, where, progress);
+        const Point  shift(at.h - where.h, at.v - where.v);
+
         Lines lines;
-        lines.draw(site.a, site.b, site.light);
-        lines.draw(site.a, site.c, site.light);
-        lines.draw(site.b, site.c, site.dark);
+        draw_triangle(lines, site, shift);
 
         SiteData control = {};
         if (player.show_select()) {
@@ -583,9 +614,7 @@ void draw_site(const PlayerShip& player) {
         }
         if (control.should_draw) {
             update_triangle(control, player.control_direction(), kSiteDistance - 3, kSiteSize - 6);
-            lines.draw(control.a, control.b, control.light);
-            lines.draw(control.a, control.c, control.light);
-            lines.draw(control.b, control.c, control.dark);
+            draw_triangle(lines, control, shift);
         }
     }
 }
@@ -604,15 +633,36 @@ void update_sector_lines() {
         sys.sound.zoom();
     }
 
-    gLastScale        = gAbsoluteScale;
-    gLastGlobalCorner = gGlobalCorner;
+    gPreviousScale        = gLastScale;
+    gPreviousGlobalCorner = gLastGlobalCorner;
+    gLastScale            = gAbsoluteScale;
+    gLastGlobalCorner     = gGlobalCorner;
 }
 
-void draw_sector_lines() {
-    Rects    rects;
-    int32_t  x;
-    uint32_t size, level, h, division;
-    RgbColor color;
+// The corner of the view between the previous tick and the current one, as interpolate() would
+// place it.  Not interpolated across zooms.
+static coordPointType interpolated_corner(int32_t progress) {
+    if ((progress >= 256) || (gPreviousScale != gLastScale)) {
+        return gLastGlobalCorner;
+    }
+    const int64_t dh = static_cast<int32_t>(gLastGlobalCorner.h - gPreviousGlobalCorner.h);
+    const int64_t dv = static_cast<int32_t>(gLastGlobalCorner.v - gPreviousGlobalCorner.v);
+    if ((std::abs((dh * gLastScale) >> SHIFT_SCALE) > kMaxInterpolatedMove) ||
+        (std::abs((dv * gLastScale) >> SHIFT_SCALE) > kMaxInterpolatedMove)) {
+        return gLastGlobalCorner;
+    }
+    coordPointType corner = gPreviousGlobalCorner;
+    corner.h += (dh * progress) / 256;
+    corner.v += (dv * progress) / 256;
+    return corner;
+}
+
+void draw_sector_lines(int32_t progress) {
+    Rects                rects;
+    int32_t              x;
+    uint32_t             size, level, h, division;
+    RgbColor             color;
+    const coordPointType corner = interpolated_corner(progress);
 
     size  = kSubSectorSize / 4;
     level = 1;
@@ -624,8 +674,8 @@ void draw_sector_lines() {
     level /= 2;
     level *= level;
 
-    x        = size - (gLastGlobalCorner.h & (size - 1));
-    division = ((gLastGlobalCorner.h + x) >> kSubSectorShift) & 0x0000000f;
+    x        = size - (corner.h & (size - 1));
+    division = ((corner.h + x) >> kSubSectorShift) & 0x0000000f;
     x        = ((x * gLastScale) >> SHIFT_SCALE) + viewport().left;
 
     if (should_draw_sector_lines) {
@@ -647,8 +697,8 @@ void draw_sector_lines() {
         }
     }
 
-    x        = size - (gLastGlobalCorner.v & (size - 1));
-    division = ((gLastGlobalCorner.v + x) >> kSubSectorShift) & 0x0000000f;
+    x        = size - (corner.v & (size - 1));
+    division = ((corner.v + x) >> kSubSectorShift) & 0x0000000f;
     x        = ((x * gLastScale) >> SHIFT_SCALE) + viewport().top;
 
     if (should_draw_sector_lines) {
@@ -22,6 +22,7 @@
 
 #include "drawing/color.hpp"
 #include "drawing/pix-map.hpp"
+#include "drawing/sprite-handling.hpp"
 #include "drawing/text.hpp"
 #include "game/admiral.hpp"
 #include "game/cursor.hpp"
@@ -67,6 +68,40 @@ void Label::reset() {
     }
 }
 
+void Label::copy_all(const GlobalState& from, GlobalState* to) {
+    if (!to->labels) {
+        to->labels.reset(new Label[kMaxLabelNum]);
+    }
+    for (int i = 0; i < kMaxLabelNum; ++i) {
+        to->labels[i] = from.labels[i].copy();
+    }
+}
+
+Label Label::copy() const {
+    Label copy;
+    copy.where              = where;
+    copy.offset             = offset;
+    copy.thisRect           = thisRect;
+    copy.lastRect           = lastRect;
+    copy.width              = width;
+    copy.height             = height;
+    copy.age                = age;
+    copy.text               = text.copy();
+    copy.color              = color;
+    copy.active             = active;
+    copy.killMe             = killMe;
+    copy.visible            = visible;
+    copy.object             = object;
+    copy.objectLink         = objectLink;
+    copy.lineNum            = lineNum;
+    copy.lineHeight         = lineHeight;
+    copy.keepOnScreenAnyway = keepOnScreenAnyway;
+    copy.attachedHintLine   = attachedHintLine;
+    copy.attachedToWhere    = attachedToWhere;
+    copy.retroCount         = retroCount;
+    return copy;
+}
+
 Handle<Label> Label::next_free_label() {
     for (auto label : all()) {
         if (!label->active) {
@@ -113,25 +148,30 @@ void Label::remove() {
     width = height = lineNum = lineHeight = 0;
 }
 
-void Label::draw() {
+void Label::draw(int32_t progress) {
     for (auto label : all()) {
+        if (!label->active || label->killMe || (label->text.empty()) || !label->visible ||
+            (label->thisRect.width() <= 0) || (label->thisRect.height() <= 0)) {
+            continue;
+        }
+
         // We anchor the image at the corner of the rect instead of label->where.  In some cases,
         // label->where is changed between update_all_label_contents() and draw time, but the rect
         // remains unchanged.  Since that function used to do this drawing, the rect's corner is
         // the original location we drew at.
-        Point at(label->thisRect.left, label->thisRect.top);
+        Point at = interpolate(
+                Point(label->lastRect.left, label->lastRect.top),
+                Point(label->thisRect.left, label->thisRect.top), progress);
+        Rect rect = label->thisRect;
+        rect.offset(at.h - rect.left, at.v - rect.top);
 
-        if (!label->active || label->killMe || (label->text.empty()) || !label->visible ||
-            (label->thisRect.width() <= 0) || (label->thisRect.height() <= 0)) {
-            continue;
-        }
         pn::string_view text = label->text;
         if ((0 <= label->retroCount) && (label->retroCount < text.size())) {
             text = text.substr(0, label->retroCount);
         }
         const RgbColor light = GetRGBTranslateColorShade(label->color, VERY_LIGHT);
         const RgbColor dark  = GetRGBTranslateColorShade(label->color, VERY_DARK);
-        sys.video->dither_rect(label->thisRect, dark);
+        sys.video->dither_rect(rect, dark);
         at.offset(kLabelInnerSpace, kLabelInnerSpace + sys.fonts.tactical->ascent);
 
         if (label->lineNum > 1) {
@@ -159,9 +199,15 @@ void Label::update_contents(ticks units_done) {
             continue;
         }
 
-        label->thisRect = Rect(0, 0, label->width, label->height);
+        const Rect previous = label->thisRect;
+        label->thisRect     = Rect(0, 0, label->width, label->height);
         label->thisRect.offset(label->where.h, label->where.v);
         label->thisRect.clip_to(clip);
+        if ((previous.width() > 0) && (previous.height() > 0)) {
+            label->lastRect = previous;
+        } else {
+            label->lastRect = label->thisRect;
+        }
         if ((label->thisRect.width() <= 0) || (label->thisRect.height() <= 0)) {
             continue;
         }
@@ -18,11 +18,14 @@
 
 #include "game/level.hpp"
 
+#include <algorithm>
+#include <exception>
 #include <set>
 #include <sfz/sfz.hpp>
 
 #include "data/plugin.hpp"
 #include "drawing/pix-table.hpp"
+#include "drawing/sprite-handling.hpp"
 #include "game/action.hpp"
 #include "game/admiral.hpp"
 #include "game/condition.hpp"
@@ -38,14 +41,19 @@
 #include "game/starfield.hpp"
 #include "game/sys.hpp"
 #include "game/vector.hpp"
+#include "game/workers.hpp"
 #include "lang/defines.hpp"
 #include "math/macros.hpp"
 #include "math/random.hpp"
 #include "math/rotation.hpp"
 #include "math/units.hpp"
+#include "sound/driver.hpp"
+#include "sound/fx.hpp"
 
 using sfz::range;
 using std::set;
+using std::unique_ptr;
+using std::vector;
 
 namespace antares {
 
@@ -60,6 +68,58 @@ ANTARES_GLOBAL set<int32_t> possible_objects;
 ANTARES_GLOBAL set<int32_t> possible_actions;
 #endif  // DATA_COVERAGE
 
+// Sprites and sounds that the level needs, in the order they were found.  start_construct_level()
+// finds them all, and construct_level() decodes them in batches across the worker threads, then
+// opens them in order.
+struct MediaJob {
+    enum Kind { SPRITE, SOUND } kind;
+    int16_t id;
+};
+ANTARES_GLOBAL vector<MediaJob>         media_jobs;
+ANTARES_GLOBAL set<std::pair<int, int>> media_found;
+
+void AddSpriteMedia(int16_t id) {
+    if (!sys.pix.get(id) && media_found.insert({MediaJob::SPRITE, id}).second) {
+        media_jobs.push_back(MediaJob{MediaJob::SPRITE, id});
+    }
+}
+
+void AddSoundMedia(int16_t id) {
+    if (!sys.sound.loaded(id) && media_found.insert({MediaJob::SOUND, id}).second) {
+        media_jobs.push_back(MediaJob{MediaJob::SOUND, id});
+    }
+}
+
+void LoadMedia(int32_t begin, int32_t end) {
+    const int32_t                    count = end - begin;
+    vector<unique_ptr<NatePixTable>> pix(count);
+    vector<unique_ptr<DecodedSound>> sounds(count);
+    vector<std::exception_ptr>       errors(count);
+    parallel_for(count, [begin, &pix, &sounds, &errors](int i) {
+        const MediaJob& job = media_jobs[begin + i];
+        try {
+            if (job.kind == MediaJob::SPRITE) {
+                pix[i].reset(new NatePixTable(Pix::load(job.id)));
+            } else {
+                sounds[i] = SoundFX::decode(job.id);
+            }
+        } catch (...) {
+            errors[i] = std::current_exception();
+        }
+    });
+
+    for (int32_t i = 0; i < count; ++i) {
+        const MediaJob& job = media_jobs[begin + i];
+        if (errors[i]) {
+            std::rethrow_exception(errors[i]);
+        } else if (job.kind == MediaJob::SPRITE) {
+            sys.pix.insert(job.id, std::move(*pix[i]));
+        } else {
+            sys.sound.insert(job.id, std::move(sounds[i]));
+        }
+    }
+}
+
 void AddBaseObjectActionMedia(
         Handle<BaseObject> base, HandleList<Action>(BaseObject::*whichType), uint8_t color,
         uint32_t all_colors);
@@ -90,7 +150,7 @@ void AddBaseObjectMedia(Handle<BaseObject> base, uint8_t color, uint32_t all_col
 
         if (base->pixResID != kNoSpriteTable) {
             int16_t id = base->pixResID + (i << kSpriteTableColorShift);
-            sys.pix.add(id);
+            AddSpriteMedia(id);
         }
 
         AddBaseObjectActionMedia(base, &BaseObject::destroy, i, all_colors);
@@ -137,7 +197,7 @@ void AddActionMedia(Handle<Action> action, uint8_t color, uint32_t all_colors) {
             l1 = action->argument.playSound.idMinimum;
             l2 = action->argument.playSound.idMinimum + action->argument.playSound.idRange;
             for (int32_t count = l1; count <= l2; count++) {
-                sys.sound.load(count);
+                AddSoundMedia(count);
             }
             break;
 
@@ -200,64 +260,6 @@ int32_t Level::prologue_id() const { return prologueID; }
 
 int32_t Level::epilogue_id() const { return epilogueID; }
 
-bool start_construct_level(Handle<Level> level, int32_t* max) {
-    ResetAllSpaceObjects();
-    reset_action_queue();
-    Vectors::reset();
-    ResetAllSprites();
-    Label::reset();
-    ResetInstruments();
-    Admiral::reset();
-    ResetAllDestObjectData();
-    ResetMotionGlobals();
-    gAbsoluteScale = kTimesTwoScale;
-    g.sync         = 0;
-
-    g.level = level;
-
-    {
-        int32_t angle = g.level->angle();
-        if (angle < 0) {
-            g.angle = g.random.next(ROT_POS);
-        } else {
-            g.angle = angle;
-        }
-    }
-
-    g.victor       = Admiral::none();
-    g.next_level   = -1;
-    g.victory_text = -1;
-
-    SetMiniScreenStatusStrList(g.level->scoreStringResID);
-
-    for (int i = 0; i < g.level->playerNum; i++) {
-        if (g.level->player[i].playerType == kSingleHumanPlayer) {
-            auto admiral = Admiral::make(i, kAIsHuman, g.level->player[i]);
-            admiral->pay(Fixed::from_long(5000));
-            g.admiral = admiral;
-        } else {
-            auto admiral = Admiral::make(i, kAIsComputer, g.level->player[i]);
-            admiral->pay(Fixed::from_long(5000));
-        }
-    }
-
-    // *** END INIT ADMIRALS ***
-
-    ///// FIRST SELECT WHAT MEDIA WE NEED TO USE:
-
-    // uncheck all base objects
-    SetAllBaseObjectsUnchecked();
-    // uncheck all sounds
-
-    sys.pix.reset();
-    sys.sound.reset();
-
-    *max = g.level->initialNum * 3L + 1 +
-           g.level->startTime.count();  // for each run through the initial num
-
-    return true;
-}
-
 static void load_blessed_objects(uint32_t all_colors) {
     if (!plug.meta.energyBlobID.get()) {
         throw std::runtime_error("No energy blob defined");
@@ -308,11 +310,11 @@ static void load_initial(int i, uint32_t all_colors) {
     // make sure we're not overriding the sprite
     if (initial->spriteIDOverride >= 0) {
         if (baseObject->attributes & kCanThink) {
-            sys.pix.add(
+            AddSpriteMedia(
                     initial->spriteIDOverride +
                     (GetAdmiralColor(owner) << kSpriteTableColorShift));
         } else {
-            sys.pix.add(initial->spriteIDOverride);
+            AddSpriteMedia(initial->spriteIDOverride);
         }
     }
 
@@ -342,6 +344,85 @@ static void load_condition(int i, uint32_t all_colors) {
     condition->set_true_yet(condition->flags & kInitiallyTrue);
 }
 
+static uint32_t level_colors() {
+    uint32_t all_colors = kNeutralColorNeededFlag;
+    for (auto adm : Admiral::all()) {
+        if (adm->active()) {
+            all_colors |= kNeutralColorNeededFlag << GetAdmiralColor(adm);
+        }
+    }
+    return all_colors;
+}
+
+bool start_construct_level(Handle<Level> level, int32_t* max) {
+    ResetAllSpaceObjects();
+    reset_action_queue();
+    Vectors::reset();
+    ResetAllSprites();
+    Label::reset();
+    ResetInstruments();
+    Admiral::reset();
+    ResetAllDestObjectData();
+    ResetMotionGlobals();
+    gAbsoluteScale = kTimesTwoScale;
+    g.sync         = 0;
+
+    g.level = level;
+
+    {
+        int32_t angle = g.level->angle();
+        if (angle < 0) {
+            g.angle = g.random.next(ROT_POS);
+        } else {
+            g.angle = angle;
+        }
+    }
+
+    g.victor       = Admiral::none();
+    g.next_level   = -1;
+    g.victory_text = -1;
+
+    SetMiniScreenStatusStrList(g.level->scoreStringResID);
+
+    for (int i = 0; i < g.level->playerNum; i++) {
+        if (g.level->player[i].playerType == kSingleHumanPlayer) {
+            auto admiral = Admiral::make(i, kAIsHuman, g.level->player[i]);
+            admiral->pay(Fixed::from_long(5000));
+            g.admiral = admiral;
+        } else {
+            auto admiral = Admiral::make(i, kAIsComputer, g.level->player[i]);
+            admiral->pay(Fixed::from_long(5000));
+        }
+    }
+
+    // *** END INIT ADMIRALS ***
+
+    ///// FIRST SELECT WHAT MEDIA WE NEED TO USE:
+
+    // uncheck all base objects
+    SetAllBaseObjectsUnchecked();
+    // uncheck all sounds
+
+    sys.pix.reset();
+    sys.sound.reset();
+
+    media_jobs.clear();
+    media_found.clear();
+    const uint32_t all_colors = level_colors();
+    load_blessed_objects(all_colors);
+    for (int i = 0; i < g.level->initialNum; i++) {
+        load_initial(i, all_colors);
+    }
+    for (int i = 0; i < g.level->conditionNum; i++) {
+        load_condition(i, all_colors);
+    }
+
+    *max = media_jobs.size() + g.level->initialNum * 2L + 1 +
+           g.level->startTime.count();  // for each run through the initial num
+
+    return true;
+}
+
 static void run_game_1s() {
     game_ticks start_time = game_ticks(-g.level->startTime);
     do {
@@ -360,34 +441,25 @@ static void run_game_1s() {
 }
 
 void construct_level(Handle<Level> level, int32_t* current) {
-    int32_t  step       = *current;
-    uint32_t all_colors = kNeutralColorNeededFlag;
-    for (auto adm : Admiral::all()) {
-        if (adm->active()) {
-            all_colors |= kNeutralColorNeededFlag << GetAdmiralColor(adm);
-        }
+    const int32_t media = media_jobs.size();
+    int32_t       step  = *current;
+    if (step < media) {
+        // Each step loads a batch of media, so that the worker threads have enough to share.
+        const int32_t batch = (worker_threads() > 1) ? (worker_threads() * 4) : 1;
+        *current            = std::min(step + batch, media);
+        LoadMedia(step, *current);
+        return;
     }
 
-    if (step == 0) {
-        load_blessed_objects(all_colors);
-        load_initial(step, all_colors);
-    } else if (step < g.level->initialNum) {
-        load_initial(step, all_colors);
-    } else if (step == g.level->initialNum) {
-        // add media for all condition actions
-        step -= g.level->initialNum;
-        for (int i = 0; i < g.level->conditionNum; i++) {
-            load_condition(i, all_colors);
-        }
+    step -= media;
+    const uint32_t all_colors = level_colors();
+    if (step < g.level->initialNum) {
         create_initial(g.level->initial(step), all_colors);
     } else if (step < (2 * g.level->initialNum)) {
-        step -= g.level->initialNum;
-        create_initial(g.level->initial(step), all_colors);
-    } else if (step < (3 * g.level->initialNum)) {
         // double back and set up any defined initial destinations
-        step -= (2 * g.level->initialNum);
+        step -= g.level->initialNum;
         set_initial_destination(g.level->initial(step), false);
-    } else if (step == (3 * g.level->initialNum)) {
+    } else if (step == (2 * g.level->initialNum)) {
         RecalcAllAdmiralBuildData();  // set up all the admiral's destination objects
         Messages::clear();
         g.time = game_ticks(-g.level->startTime);
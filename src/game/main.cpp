@@ -37,6 +37,7 @@
 #include "drawing/text.hpp"
 #include "game/action.hpp"
 #include "game/admiral.hpp"
+#include "game/checkpoint.hpp"
 #include "game/condition.hpp"
 #include "game/cursor.hpp"
 #include "game/globals.hpp"
@@ -50,6 +51,7 @@
 #include "game/non-player-ship.hpp"
 #include "game/player-ship.hpp"
 #include "game/starfield.hpp"
+#include "game/sync-trace.hpp"
 #include "game/sys.hpp"
 #include "game/time.hpp"
 #include "game/vector.hpp"
@@ -94,7 +96,7 @@ Rect viewport() {
 
 class GamePlay : public Card {
   public:
-    GamePlay(bool replay, InputSource* input, GameResult* game_result);
+    GamePlay(bool replay, bool headless, InputSource* input, GameResult* game_result);
 
     virtual void become_front();
     virtual void resign_front();
@@ -126,6 +128,7 @@ class GamePlay : public Card {
     State _state;
 
     const bool            _replay;
+    const bool            _headless;
     GameResult* const     _game_result;
     wall_time             _next_timer;
     const Rect            _play_area;
@@ -147,11 +150,12 @@ class GamePlay : public Card {
 
 MainPlay::MainPlay(
         Handle<Level> level, bool replay, InputSource* input, bool show_loading_screen,
-        GameResult* game_result)
+        bool headless, GameResult* game_result)
         : _state(NEW),
           _level(level),
           _replay(replay),
           _show_loading_screen(show_loading_screen),
+          _headless(headless),
           _cancelled(false),
           _game_result(game_result),
           _input_source(input) {}
@@ -218,7 +222,7 @@ void MainPlay::become_front() {
 
             sys.music.play(Music::IN_GAME, g.level->songID);
 
-            stack()->push(new GamePlay(_replay, _input_source, _game_result));
+            stack()->push(new GamePlay(_replay, _headless, _input_source, _game_result));
         } break;
 
         case PLAYING:
@@ -253,9 +257,10 @@ void MainPlay::become_front() {
     }
 }
 
-GamePlay::GamePlay(bool replay, InputSource* input, GameResult* game_result)
+GamePlay::GamePlay(bool replay, bool headless, InputSource* input, GameResult* game_result)
         : _state(PLAYING),
           _replay(replay),
+          _headless(headless),
           _game_result(game_result),
           _next_timer(now() + kMinorTick),
           _play_area(viewport().left, viewport().top, viewport().right, viewport().bottom),
@@ -420,14 +425,18 @@ void GamePlay::become_front() {
 void GamePlay::resign_front() { minicomputer_cancel(); }
 
 void GamePlay::draw() const {
-    globals()->starfield.draw();
-    draw_sector_lines();
-    Vectors::draw();
-    draw_sprites();
-    Label::draw();
+    // Ticks and frames still run on the same thread, so a slow frame delays the next tick.  There
+    // is no separate snapshot of the game to draw from: interpolation uses the previous positions
+    // that each sprite, vector, and label keeps alongside its current one.
+    const int32_t progress = draw_progress(now() - _real_time);
+    globals()->starfield.draw(progress);
+    draw_sector_lines(progress);
+    Vectors::draw(progress);
+    draw_sprites(progress);
+    Label::draw(progress);
 
     Messages::draw_message();
-    draw_site(_player_ship);
+    draw_site(_player_ship, progress);
     draw_instruments();
     if (stack()->top() == this) {
         _player_ship.cursor().draw();
@@ -481,8 +490,11 @@ void GamePlay::fire_timer() {
         }
 
         // executed arbitrarily, but at least once every major tick
-        globals()->starfield.prepare_to_move();
-        globals()->starfield.move(unitsToDo);
+        if (!_headless) {
+            RememberSpritePositions();
+            globals()->starfield.prepare_to_move();
+            globals()->starfield.move(unitsToDo);
+        }
         MoveSpaceObjects(unitsToDo);
 
         g.time += unitsToDo;
@@ -505,27 +517,44 @@ void GamePlay::fire_timer() {
             if ((g.time.time_since_epoch() % kConditionTick) == ticks(0)) {
                 CheckLevelConditions();
             }
+
+            trace_sync();
+            checkpoint_tick(&_player_ship);
         }
 
-        UpdateMiniScreenLines();
+        // In headless mode, skip updates that only matter for drawing. Long
+        // messages can trigger level conditions, the radar sets the scale
+        // that new objects are placed by, and dead sprites and vectors must
+        // be culled so their slots can be reused; those always run.
+        if (!_headless) {
+            UpdateMiniScreenLines();
+        }
 
         Messages::clip();
         Messages::draw_long_message(unitsToDo);
 
-        update_sector_lines();
-        Vectors::update();
-        Label::update_positions(unitsToDo);
-        Label::update_contents(unitsToDo);
-        update_site(_replay);
+        if (!_headless) {
+            update_sector_lines();
+            Vectors::update();
+            Label::update_positions(unitsToDo);
+            Label::update_contents(unitsToDo);
+            update_site(_replay);
+        }
 
         CullSprites();
-        Label::show_all();
-        Vectors::show_all();
-        globals()->starfield.show();
+        if (_headless) {
+            Vectors::cull();
+        } else {
+            Label::show_all();
+            Vectors::show_all();
+            globals()->starfield.show();
+            Messages::draw_message_screen(unitsToDo);
+        }
 
-        Messages::draw_message_screen(unitsToDo);
         UpdateRadar(unitsToDo);
-        globals()->transitions.update_boolean(unitsToDo);
+        if (!_headless) {
+            globals()->transitions.update_boolean(unitsToDo);
+        }
 
         unitsPassed -= unitsToDo;
     }
@@ -107,6 +107,8 @@ struct Messages::longMessageType {
     bool                        labelMessage;
     bool                        lastLabelMessage;
     Handle<Label>               labelMessageID;
+
+    longMessageType copy() const;
 };
 
 ANTARES_GLOBAL std::queue<pn::string> Messages::message_data;
@@ -115,6 +117,80 @@ ANTARES_GLOBAL ticks Messages::time_count;
 
 void MessageLabel_Set_Special(Handle<Label> id, pn::string_view text);
 
+// Lays out `text` for the long message box along the bottom of the screen.
+static unique_ptr<StyledText> long_message_text(pn::string_view text) {
+    const RgbColor&        light_blue = GetRGBTranslateColorShade(SKY_BLUE, VERY_LIGHT);
+    const RgbColor&        dark_blue  = GetRGBTranslateColorShade(SKY_BLUE, DARKEST);
+    unique_ptr<StyledText> retro_text(new StyledText(sys.fonts.tactical));
+    retro_text->set_fore_color(light_blue);
+    retro_text->set_back_color(dark_blue);
+    retro_text->set_retro_text(text);
+    retro_text->set_tab_width(60);
+    retro_text->wrap_to(
+            viewport().width() - kHBuffer - sys.fonts.tactical->logicalWidth + 1, 0, 0);
+    return retro_text;
+}
+
+// The laid-out text isn't copied, but laid out again from `text`.
+Messages::longMessageType Messages::longMessageType::copy() const {
+    longMessageType copy;
+    copy.stage              = stage;
+    copy.charDelayCount     = charDelayCount;
+    copy.pictBounds         = pictBounds;
+    copy.pictDelayCount     = pictDelayCount;
+    copy.pictCurrentLeft    = pictCurrentLeft;
+    copy.pictCurrentTop     = pictCurrentTop;
+    copy.time               = time;
+    copy.textHeight         = textHeight;
+    copy.startResID         = startResID;
+    copy.endResID           = endResID;
+    copy.currentResID       = currentResID;
+    copy.lastResID          = lastResID;
+    copy.previousStartResID = previousStartResID;
+    copy.previousEndResID   = previousEndResID;
+    copy.pictID             = pictID;
+    copy.backColor          = backColor;
+    copy.stringMessage      = stringMessage.copy();
+    copy.lastStringMessage  = lastStringMessage.copy();
+    copy.newStringMessage   = newStringMessage;
+    copy.text               = text.copy();
+    if (retro_text) {
+        copy.retro_text = long_message_text(text);
+    }
+    copy.retro_origin     = retro_origin;
+    copy.at_char          = at_char;
+    copy.labelMessage     = labelMessage;
+    copy.lastLabelMessage = lastLabelMessage;
+    copy.labelMessageID   = labelMessageID;
+    return copy;
+}
+
+Messages::State::State() {}
+
+Messages::State::~State() {}
+
+void Messages::save(State* state) {
+    std::queue<pn::string> pending;
+    state->message_data.clear();
+    while (!message_data.empty()) {
+        state->message_data.push_back(message_data.front().copy());
+        pending.push(std::move(message_data.front()));
+        message_data.pop();
+    }
+    swap(message_data, pending);
+    state->long_message_data.reset(new longMessageType(long_message_data->copy()));
+    state->time_count = time_count;
+}
+
+void Messages::restore(const State& state) {
+    antares::clear(message_data);
+    for (const pn::string& message : state.message_data) {
+        message_data.push(message.copy());
+    }
+    *long_message_data = state.long_message_data->copy();
+    time_count         = state.time_count;
+}
+
 void Messages::init() {
     longMessageType* tmessage = NULL;
 
@@ -248,17 +324,8 @@ void Messages::clip(void)
                     tmessage->labelMessage = false;
             }
             if (textData.get() != NULL) {
-                const RgbColor& light_blue = GetRGBTranslateColorShade(SKY_BLUE, VERY_LIGHT);
-                const RgbColor& dark_blue  = GetRGBTranslateColorShade(SKY_BLUE, DARKEST);
-                tmessage->text             = textData->copy();
-                tmessage->retro_text.reset(new StyledText(sys.fonts.tactical));
-                tmessage->retro_text->set_fore_color(light_blue);
-                tmessage->retro_text->set_back_color(dark_blue);
-                tmessage->retro_text->set_retro_text(*textData);
-                tmessage->retro_text->set_tab_width(60);
-                tmessage->retro_text->wrap_to(
-                        viewport().width() - kHBuffer - sys.fonts.tactical->logicalWidth + 1, 0,
-                        0);
+                tmessage->text       = textData->copy();
+                tmessage->retro_text = long_message_text(*textData);
                 tmessage->textHeight = tmessage->retro_text->height();
                 tmessage->textHeight += kLongMessageVPadDouble;
                 tmessage->retro_origin =
@@ -226,6 +226,39 @@ void MiniScreenCleanup() {
     // g.mini.objectData.reset();
 }
 
+void MiniScreenCopy(const GlobalState& from, GlobalState* to) {
+    to->mini.selectLine    = from.mini.selectLine;
+    to->mini.currentScreen = from.mini.currentScreen;
+    to->mini.clickLine     = from.mini.clickLine;
+
+    if (!to->mini.lineData) {
+        to->mini.lineData.reset(new miniScreenLineType[kMiniScreenTrueLineNum]);
+    }
+    for (int32_t i = 0; i < kMiniScreenTrueLineNum; i++) {
+        to->mini.lineData[i] = from.mini.lineData[i].copy();
+    }
+}
+
+miniScreenLineType miniScreenLineType::copy() const {
+    miniScreenLineType copy;
+    copy.kind          = kind;
+    copy.string        = string.copy();
+    copy.statusFalse   = statusFalse.copy();
+    copy.statusTrue    = statusTrue.copy();
+    copy.statusString  = statusString.copy();
+    copy.postString    = postString.copy();
+    copy.whichButton   = whichButton;
+    copy.underline     = underline;
+    copy.value         = value;
+    copy.statusType    = statusType;
+    copy.whichStatus   = whichStatus;
+    copy.statusPlayer  = statusPlayer;
+    copy.negativeValue = negativeValue;
+    copy.sourceData    = sourceData;
+    copy.callback      = callback;
+    return copy;
+}
+
 #pragma mark -
 
 void SetMiniScreenStatusStrList(int16_t strID) {
@@ -808,7 +841,7 @@ static void build_ship(Handle<Admiral> adm, int32_t line) {
         return;
     }
     if (CountObjectsOfBaseType(BaseObject::none(), Admiral::none()) <
-        (kMaxSpaceObject - kMaxShipBuffer)) {
+        (SpaceObject::capacity() - kMaxShipBuffer)) {
         if (adm->build(line - kBuildScreenFirstTypeLine) == false) {
             if (adm == g.admiral) {
                 sys.sound.warning();
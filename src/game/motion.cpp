@@ -18,6 +18,9 @@
 
 #include "game/motion.hpp"
 
+#include <algorithm>
+#include <vector>
+
 #include "data/base-object.hpp"
 #include "drawing/color.hpp"
 #include "drawing/pix-table.hpp"
@@ -29,6 +32,7 @@
 #include "game/player-ship.hpp"
 #include "game/space-object.hpp"
 #include "game/vector.hpp"
+#include "game/workers.hpp"
 #include "lang/defines.hpp"
 #include "math/macros.hpp"
 #include "math/random.hpp"
@@ -83,6 +87,24 @@ const static Point kAdjacentUnits[] = {{0, 0}, {1, 0}, {-1, 1}, {0, 1}, {1, 1}};
 ANTARES_GLOBAL coordPointType gGlobalCorner;
 static ANTARES_GLOBAL unique_ptr<proximityUnitType[]> gProximityGrid;
 
+// The objects in each cell of gProximityGrid, packed into one array sorted by cell.  Cell i holds
+// entries [start[i], start[i + 1]), most recently added first, which is the order that the
+// per-cell linked lists this replaces would have visited them in.
+struct ProximityBuckets {
+    struct Entry {
+        Handle<SpaceObject> object;
+        Point               grid;
+        uint8_t             cell;
+    };
+    std::vector<Entry> added;  // in the order added, before sorting
+
+    std::vector<int32_t>             start;
+    std::vector<Handle<SpaceObject>> object;
+    std::vector<Point>               grid;  // collisionGrid or distanceGrid of `object`
+};
+static ANTARES_GLOBAL ProximityBuckets gNearBuckets;  // for collision checking
+static ANTARES_GLOBAL ProximityBuckets gFarBuckets;   // for distance checking
+
 static void correct_physical_space(Handle<SpaceObject> a, Handle<SpaceObject> b);
 
 Size center_scale() {
@@ -98,7 +120,6 @@ void InitMotion() {
     for (int y = 0; y < kProximitySuperSize; y++) {
         for (int x = 0; x < kProximitySuperSize; x++) {
             proximityUnitType* p = &gProximityGrid[(y << kProximityWidthMultiply) + x];
-            p->nearObject = p->farObject = SpaceObject::none();
             for (int i = 0; i < kUnitsToCheckNumber; i++) {
                 int32_t ux = x;
                 int32_t uy = y;
@@ -134,8 +155,11 @@ void ResetMotionGlobals() {
     g.closest                         = Handle<SpaceObject>(0);
     g.farthest                        = Handle<SpaceObject>(0);
 
-    for (int i = 0; i < kProximityGridDataLength; i++) {
-        gProximityGrid[i].nearObject = gProximityGrid[i].farObject = SpaceObject::none();
+    for (ProximityBuckets* b : {&gNearBuckets, &gFarBuckets}) {
+        b->added.clear();
+        b->start.assign(kProximityGridDataLength + 1, 0);
+        b->object.clear();
+        b->grid.clear();
     }
 }
 
@@ -487,6 +511,28 @@ static void activate_object(const Handle<SpaceObject>& o) {
     }
 }
 
+// Sorts the objects added to `b` into their cells with a counting sort.  Each cell is filled from
+// its end, so that within a cell, the most recently added object comes first.
+static void sort_buckets(ProximityBuckets& b) {
+    b.start.assign(kProximityGridDataLength + 1, 0);
+    for (const auto& e : b.added) {
+        ++b.start[e.cell + 1];
+    }
+    for (int32_t i = 0; i < kProximityGridDataLength; i++) {
+        b.start[i + 1] += b.start[i];
+    }
+
+    int32_t end[kProximityGridDataLength];
+    std::copy(b.start.begin() + 1, b.start.end(), end);
+    b.object.resize(b.added.size());
+    b.grid.resize(b.added.size());
+    for (const auto& e : b.added) {
+        const int32_t i = --end[e.cell];
+        b.object[i]     = e.object;
+        b.grid[i]       = e.grid;
+    }
+}
+
 static void calc_misc() {
     // set up player info so we can find closest ship (for scaling)
     uint64_t farthestDist = 0;
@@ -494,9 +540,8 @@ static void calc_misc() {
     g.closest = g.farthest = Handle<SpaceObject>(0);
 
     // reset the collision grid
-    for (int32_t i = 0; i < kProximityGridDataLength; i++) {
-        gProximityGrid[i].nearObject = gProximityGrid[i].farObject = SpaceObject::none();
-    }
+    gNearBuckets.added.clear();
+    gFarBuckets.added.clear();
 
     for (auto o = g.root; o.get(); o = o->nextObject) {
         if (!o->active) {
@@ -554,10 +599,10 @@ static void calc_misc() {
                 int32_t x2 = loc.h >> kCollisionSuperUnitBitShift;
                 int32_t y1 = (loc.v >> kCollisionUnitBitShift) & kProximityUnitAndModulo;
                 int32_t y2 = loc.v >> kCollisionSuperUnitBitShift;
-                auto&   proximityObject    = gProximityGrid[(y1 << kProximityWidthMultiply) + x1];
-                o->nextNearObject          = proximityObject.nearObject;
-                proximityObject.nearObject = o;
-                o->collisionGrid           = {x2, y2};
+
+                o->collisionGrid = {x2, y2};
+                gNearBuckets.added.push_back(
+                        {o, o->collisionGrid, uint8_t((y1 << kProximityWidthMultiply) + x1)});
             }
 
             {
@@ -565,10 +610,10 @@ static void calc_misc() {
                 int32_t x4 = loc.h >> kDistanceSuperUnitBitShift;
                 int32_t y3 = (loc.v >> kDistanceUnitBitShift) & kProximityUnitAndModulo;
                 int32_t y4 = loc.v >> kDistanceSuperUnitBitShift;
-                auto&   proximityObject   = gProximityGrid[(y3 << kProximityWidthMultiply) + x3];
-                o->nextFarObject          = proximityObject.farObject;
-                proximityObject.farObject = o;
-                o->distanceGrid           = {x4, y4};
+
+                o->distanceGrid = {x4, y4};
+                gFarBuckets.added.push_back(
+                        {o, o->distanceGrid, uint8_t((y3 << kProximityWidthMultiply) + x3)});
             }
 
             if (!(o->attributes & kIsDestination)) {
@@ -581,6 +626,18 @@ static void calc_misc() {
             }
         }
     }
+
+    sort_buckets(gNearBuckets);
+    sort_buckets(gFarBuckets);
+
+    // Admirals walk the objects in a distance cell by following nextFarObject.
+    const auto& far = gFarBuckets;
+    for (int32_t i = 0; i < kProximityGridDataLength; i++) {
+        for (int32_t j = far.start[i]; j < far.start[i + 1]; ++j) {
+            far.object[j]->nextFarObject =
+                    (j + 1 < far.start[i + 1]) ? far.object[j + 1] : SpaceObject::none();
+        }
+    }
 }
 
 // Collision uses inclusive rect bounds for historical reasons.
@@ -709,15 +766,19 @@ static void calc_bounds() {
 
 // Call HitObject() and CorrectPhysicalSpace() for all colliding pairs of objects.
 static void calc_impacts() {
+    const auto& near = gNearBuckets;
     for (int32_t i = 0; i < kProximityGridDataLength; i++) {
         const auto& cell = gProximityGrid[i];
-        for (auto a = cell.nearObject; a.get(); a = a->nextNearObject) {
+        for (int32_t ai = near.start[i]; ai < near.start[i + 1]; ++ai) {
+            const auto a = near.object[ai];
             for (int32_t k = 0; k < kUnitsToCheckNumber; k++) {
-                Handle<SpaceObject> b     = a->nextNearObject;
-                Point               super = a->collisionGrid;
+                int32_t bi    = ai + 1;
+                int32_t bend  = near.start[i + 1];
+                Point   super = near.grid[ai];
                 if (k > 0) {
                     const auto& adj = cell.unitsToCheck[k];
-                    b               = gProximityGrid[adj.adjacentUnit].nearObject;
+                    bi              = near.start[adj.adjacentUnit];
+                    bend            = near.start[adj.adjacentUnit + 1];
                     super.offset(adj.superOffset.h, adj.superOffset.v);
                 }
 
@@ -725,11 +786,15 @@ static void calc_impacts() {
                     continue;
                 }
 
-                for (; b.get(); b = b->nextNearObject) {
+                for (; bi < bend; ++bi) {
+                    if (near.grid[bi] != super) {
+                        continue;
+                    }
+                    const auto b = near.object[bi];
+
                     // this'll be true even ONLY if BOTH objects are not non-physical dest object
                     if (!((b->attributes | a->attributes) & kCanCollide) ||
-                        !((b->attributes | a->attributes) & kCanBeHit) ||
-                        (b->collisionGrid != super)) {
+                        !((b->attributes | a->attributes) & kCanBeHit)) {
                         continue;
                     }
 
@@ -764,32 +829,51 @@ static void calc_impacts() {
     }
 }
 
-// Sets the following properties on objects:
-//   * closestObject
-//   * closestDistance
-//   * localFriendStrength
-//   * localFoeStrength
-// Also sets seenByPlayerFlags and kIsHidden based on object proximity.
-static void calc_locality() {
-    for (int32_t i = 0; i < kProximityGridDataLength; i++) {
+// A pair of objects in neighboring distance cells that affect each other's locality.
+struct LocalityPair {
+    Handle<SpaceObject> a;
+    Handle<SpaceObject> b;
+    uint32_t            dist;
+    uint8_t             effects;
+};
+const uint8_t kLocalityFoes      = 0x01;  // a and b are potential enemies
+const uint8_t kLocalityNeighbors = 0x02;  // a and b aren't enemies, but share a cell
+const uint8_t kLocalityInRange   = 0x04;  // a and b can see each other
+const uint8_t kLocalityATargetsB = 0x08;  // a engages b, and b is a potential target
+const uint8_t kLocalityBTargetsA = 0x10;  // b engages a, and a is a potential target
+
+// Pairs found by each task of calc_locality(), in the order the serial scan would visit them.
+static ANTARES_GLOBAL std::vector<std::vector<LocalityPair>> gLocalityPairs;
+
+// Finds the pairs that calc_locality() needs to apply, for objects in cells [begin, end).  Reads
+// only properties of objects that calc_locality() doesn't change, so that it can run in parallel
+// with itself.
+static void find_locality_pairs(int32_t begin, int32_t end, std::vector<LocalityPair>* pairs) {
+    const auto& far = gFarBuckets;
+    pairs->clear();
+    for (int32_t i = begin; i < end; i++) {
         const auto& cell = gProximityGrid[i];
-        for (auto a = cell.farObject; a.get(); a = a->nextFarObject) {
+        for (int32_t ai = far.start[i]; ai < far.start[i + 1]; ++ai) {
+            const auto a = far.object[ai];
             for (int32_t k = 0; k < kUnitsToCheckNumber; k++) {
-                Handle<SpaceObject> b     = a->nextFarObject;
-                Point               super = a->distanceGrid;
+                int32_t bi    = ai + 1;
+                int32_t bend  = far.start[i + 1];
+                Point   super = far.grid[ai];
                 if (k > 0) {
                     const auto& adj = cell.unitsToCheck[k];
-                    b               = gProximityGrid[adj.adjacentUnit].farObject;
+                    bi              = far.start[adj.adjacentUnit];
+                    bend            = far.start[adj.adjacentUnit + 1];
                     super.offset(adj.superOffset.h, adj.superOffset.v);
                 }
                 if ((super.h < 0) || (super.v < 0)) {
                     continue;
                 }
 
-                for (; b.get(); b = b->nextFarObject) {
-                    if (b->distanceGrid != super) {
+                for (; bi < bend; ++bi) {
+                    if (far.grid[bi] != super) {
                         continue;
                     }
+                    const auto b = far.object[bi];
                     if ((b->owner != a->owner) &&
                         ((b->attributes & kCanThink) || (b->attributes & kRemoteOrHuman) ||
                          (b->attributes & kHated)) &&
@@ -805,44 +889,22 @@ static void calc_locality() {
                             dist = (y_dist * y_dist) + (x_dist * x_dist);
                         }
 
+                        uint8_t effects = kLocalityFoes;
                         if (dist < kMaximumRelevantDistanceSquared) {
-                            a->seenByPlayerFlags |= b->myPlayerFlag;
-                            b->seenByPlayerFlags |= a->myPlayerFlag;
-
-                            if (b->attributes & kHideEffect) {
-                                a->runTimeFlags |= kIsHidden;
-                            }
-
-                            if (a->attributes & kHideEffect) {
-                                b->runTimeFlags |= kIsHidden;
-                            }
+                            effects |= kLocalityInRange;
                         }
-
-                        if (a->engages(*b)) {
-                            if ((dist < a->closestDistance) &&
-                                (b->attributes & kPotentialTarget)) {
-                                a->closestDistance = dist;
-                                a->closestObject   = b;
-                            }
+                        if (a->engages(*b) && (b->attributes & kPotentialTarget)) {
+                            effects |= kLocalityATargetsB;
                         }
-
-                        if (b->engages(*a)) {
-                            if ((dist < b->closestDistance) &&
-                                (a->attributes & kPotentialTarget)) {
-                                b->closestDistance = dist;
-                                b->closestObject   = a;
-                            }
+                        if (b->engages(*a) && (a->attributes & kPotentialTarget)) {
+                            effects |= kLocalityBTargetsA;
                         }
-
-                        b->localFoeStrength += a->localFriendStrength;
-                        b->localFriendStrength += a->localFoeStrength;
+                        pairs->push_back({a, b, dist, effects});
                     } else if (k == 0) {
                         if (a->owner != b->owner) {
-                            b->localFoeStrength += a->localFriendStrength;
-                            b->localFriendStrength += a->localFoeStrength;
+                            pairs->push_back({a, b, 0, kLocalityFoes});
                         } else {
-                            b->localFoeStrength += a->localFoeStrength;
-                            b->localFriendStrength += a->localFriendStrength;
+                            pairs->push_back({a, b, 0, kLocalityNeighbors});
                         }
                     }
                 }
@@ -851,6 +913,74 @@ static void calc_locality() {
     }
 }
 
+// Sets the following properties on objects:
+//   * closestObject
+//   * closestDistance
+//   * localFriendStrength
+//   * localFoeStrength
+// Also sets seenByPlayerFlags and kIsHidden based on object proximity.
+//
+// Finding the pairs of objects that affect each other is split across the worker threads, by
+// ranges of cells holding roughly equal numbers of objects.  The pairs are then applied on this
+// thread in their original order.  That order matters: an object's strength is passed on to its
+// neighbors after it has been raised by earlier pairs, and ties for closest object go to the
+// first pair found.
+static void calc_locality() {
+    const auto&   far   = gFarBuckets;
+    const int32_t tasks = (worker_threads() > 1) ? (worker_threads() * 4) : 1;
+    const int32_t total = far.object.size();
+
+    std::vector<int32_t> bounds(1, 0);
+    for (int32_t i = 0; i < kProximityGridDataLength; i++) {
+        if ((bounds.size() < tasks) && ((far.start[i + 1] * tasks) >= (total * bounds.size()))) {
+            bounds.push_back(i + 1);
+        }
+    }
+    bounds.push_back(kProximityGridDataLength);
+
+    gLocalityPairs.resize(bounds.size() - 1);
+    parallel_for(bounds.size() - 1, [&bounds](int task) {
+        find_locality_pairs(bounds[task], bounds[task + 1], &gLocalityPairs[task]);
+    });
+
+    for (const auto& pairs : gLocalityPairs) {
+        for (const auto& p : pairs) {
+            const auto a = p.a;
+            const auto b = p.b;
+            if (p.effects & kLocalityInRange) {
+                a->seenByPlayerFlags |= b->myPlayerFlag;
+                b->seenByPlayerFlags |= a->myPlayerFlag;
+
+                if (b->attributes & kHideEffect) {
+                    a->runTimeFlags |= kIsHidden;
+                }
+
+                if (a->attributes & kHideEffect) {
+                    b->runTimeFlags |= kIsHidden;
+                }
+            }
+
+            if ((p.effects & kLocalityATargetsB) && (p.dist < a->closestDistance)) {
+                a->closestDistance = p.dist;
+                a->closestObject   = b;
+            }
+
+            if ((p.effects & kLocalityBTargetsA) && (p.dist < b->closestDistance)) {
+                b->closestDistance = p.dist;
+                b->closestObject   = a;
+            }
+
+            if (p.effects & kLocalityFoes) {
+                b->localFoeStrength += a->localFriendStrength;
+                b->localFriendStrength += a->localFoeStrength;
+            } else if (p.effects & kLocalityNeighbors) {
+                b->localFoeStrength += a->localFoeStrength;
+                b->localFriendStrength += a->localFriendStrength;
+            }
+        }
+    }
+}
+
 static void calc_visibility() {
     // here, it doesn't matter in what order we step through the table
     const uint32_t seen_by_me = 1ul << g.admiral.number();
@@ -513,6 +513,42 @@ void PlayerShip::gamepad_stick(const GamepadStickEvent& event) {
     }
 }
 
+void PlayerShip::save(State* state) const {
+    const wall_time now = antares::now();
+    state->these_keys   = gTheseKeys;
+    state->gamepad_keys = _gamepad_keys;
+    state->key_presses  = _key_presses;
+    state->key_releases = _key_releases;
+    state->keys.copy(_keys);
+    state->gamepad_state     = _gamepad_state;
+    state->control_active    = _control_active;
+    state->control_direction = _control_direction;
+    state->dest_key_state    = gDestKeyState;
+    state->dest_key_held     = now - gDestKeyTime;
+    state->hot_key_state     = gHotKeyState;
+    state->hot_key_held      = now - gHotKeyTime;
+    state->hot_key_num       = gHotKeyNum;
+    state->previous_zoom     = gPreviousZoomMode;
+}
+
+void PlayerShip::restore(const State& state) {
+    const wall_time now = antares::now();
+    gTheseKeys          = state.these_keys;
+    _gamepad_keys       = state.gamepad_keys;
+    _key_presses        = state.key_presses;
+    _key_releases       = state.key_releases;
+    _keys.copy(state.keys);
+    _gamepad_state     = state.gamepad_state;
+    _control_active    = state.control_active;
+    _control_direction = state.control_direction;
+    gDestKeyState      = static_cast<DestKeyState>(state.dest_key_state);
+    gDestKeyTime       = now - state.dest_key_held;
+    gHotKeyState       = static_cast<HotKeyState>(state.hot_key_state);
+    gHotKeyTime        = now - state.hot_key_held;
+    gHotKeyNum         = state.hot_key_num;
+    gPreviousZoomMode  = static_cast<ZoomType>(state.previous_zoom);
+}
+
 bool PlayerShip::active() const {
     auto player = g.ship;
     return player.get() && player->active && (player->attributes & kIsHumanControlled);
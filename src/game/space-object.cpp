@@ -64,8 +64,8 @@ const Fixed kDefaultTurnRate = Fixed::from_long(2.000);
 ANTARES_GLOBAL set<int32_t> covered_objects;
 #endif  // DATA_COVERAGE
 
-void SpaceObjectHandlingInit() {
-    g.objects.reset(new SpaceObject[kMaxSpaceObject]);
+void SpaceObjectHandlingInit(int32_t max_objects) {
+    g.objects.reset(max_objects);
     ResetAllSpaceObjects();
     reset_action_queue();
 }
@@ -76,6 +76,7 @@ void ResetAllSpaceObjects() {
         anObject->active = kObjectAvailable;
         anObject->sprite = Sprite::none();
     }
+    g.objects.release_all();
 }
 
 BaseObject* BaseObject::get(int number) {
@@ -106,13 +107,15 @@ Handle<BaseObject> mGetBaseObjectFromClassRace(int class_, int race) {
     return BaseObject::none();
 }
 
+// Every path that frees an object (free(), ResetAllSpaceObjects(), RemoveAllSpaceObjects(), and
+// AddSpaceObject() failing) marks it available before releasing its slot, so a slot from the
+// pool is never in use.
 static Handle<SpaceObject> next_free_space_object() {
-    for (auto obj : SpaceObject::all()) {
-        if (!obj->active) {
-            return obj;
-        }
+    auto obj = Handle<SpaceObject>(g.objects.allocate());
+    if (!obj.get()) {
+        return SpaceObject::none();
     }
-    return SpaceObject::none();
+    return obj;
 }
 
 static Handle<SpaceObject> AddSpaceObject(SpaceObject* sourceObject) {
@@ -183,6 +186,7 @@ static Handle<SpaceObject> AddSpaceObject(SpaceObject* sourceObject) {
             g.game_over    = true;
             g.game_over_at = g.time;
             obj->active    = kObjectAvailable;
+            g.objects.release(obj.number());
             return SpaceObject::none();
         }
     }
@@ -209,10 +213,11 @@ void RemoveAllSpaceObjects() {
             RemoveSprite(obj->sprite);
             obj->sprite = Sprite::none();
         }
-        obj->active         = kObjectAvailable;
-        obj->nextNearObject = obj->nextFarObject = SpaceObject::none();
-        obj->attributes                          = 0;
+        obj->active        = kObjectAvailable;
+        obj->nextFarObject = SpaceObject::none();
+        obj->attributes    = 0;
     }
+    g.objects.release_all();
 }
 
 SpaceObject::SpaceObject(
@@ -498,10 +503,10 @@ void SpaceObject::change_base_type(
             spriteTable = sys.pix.add(obj->pixResID);
         }
 
-        obj->sprite->table      = spriteTable;
-        obj->sprite->tinySize   = base->tinySize;
-        obj->sprite->whichLayer = base->pixLayer;
-        obj->sprite->scale      = base->naturalScale;
+        obj->sprite->table    = spriteTable;
+        obj->sprite->tinySize = base->tinySize;
+        obj->sprite->scale    = base->naturalScale;
+        SetSpriteLayer(obj->sprite, base->pixLayer);
 
         if (obj->attributes & kIsSelfAnimated) {
             obj->sprite->whichShape = more_evil_fixed_to_long(obj->frame.animation.thisShape);
@@ -812,9 +817,10 @@ void SpaceObject::free() {
             sprite->killMe = true;
         }
     }
-    active         = kObjectAvailable;
-    attributes     = 0;
-    nextNearObject = nextFarObject = SpaceObject::none();
+    active        = kObjectAvailable;
+    attributes    = 0;
+    nextFarObject = SpaceObject::none();
+    g.objects.release(number());
     if (previousObject.get()) {
         auto bObject        = previousObject;
         bObject->nextObject = nextObject;
@@ -895,6 +901,6 @@ pn::string_view get_object_short_name(Handle<BaseObject> id) {
     return id->short_name;  // TODO(sfiera): use directly.
 }
 
-int32_t SpaceObject::number() const { return this - g.objects.get(); }
+int32_t SpaceObject::number() const { return g.objects.number(this); }
 
 }  // namespace antares
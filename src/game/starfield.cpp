@@ -232,7 +232,7 @@ void Starfield::move(ticks by_units) {
     }
 }
 
-void Starfield::draw() const {
+void Starfield::draw(int32_t progress) const {
     const RgbColor slowColor   = GetRGBTranslateColorShade(kStarColor, MEDIUM);
     const RgbColor mediumColor = GetRGBTranslateColorShade(kStarColor, LIGHT);
     const RgbColor fastColor   = GetRGBTranslateColorShade(kStarColor, LIGHTER);
@@ -251,7 +251,9 @@ void Starfield::draw() const {
                             color = &fastColor;
                         }
 
-                        points.draw(star->location, *color);
+                        points.draw(
+                                interpolate(star->oldLocation, star->location, progress),
+                                *color);
                     }
                 }
                 break;
@@ -284,7 +286,7 @@ void Starfield::draw() const {
         if ((star->speed != kNoStar) && (star->age > 0)) {
             const RgbColor color = GetRGBTranslateColorShade(
                     star->color, (star->age >> kSparkAgeToShadeShift) + 1);
-            points.draw(star->location, color);
+            points.draw(interpolate(star->oldLocation, star->location, progress), color);
         }
     }
 }
@@ -0,0 +1,328 @@
+// Copyright (C) 1997, 1999-2001, 2008 Nathan Lamont
+// Copyright (C) 2008-2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#include "game/sync-trace.hpp"
+
+#include <string.h>
+#include <algorithm>
+#include <stdexcept>
+
+#include "game/action.hpp"
+#include "game/admiral.hpp"
+#include "game/globals.hpp"
+#include "game/space-object.hpp"
+#include "lang/defines.hpp"
+
+namespace antares {
+
+// A trace file starts with kSyncTraceMagic and the number of fields per record.  Each record
+// follows as the tick, as a varint counting up from the previous record's tick, then the hash
+// of each field as 4 big-endian bytes.
+static const char kSyncTraceMagic[] = "ANSYNC01";
+
+static ANTARES_GLOBAL SyncTrace* gSyncTrace = nullptr;
+
+void SyncHash::add(int64_t value) {
+    for (int i = 0; i < 8; ++i) {
+        _value ^= (value >> (i * 8)) & 0xff;
+        _value *= 16777619u;
+    }
+}
+
+static void hash_objects(SyncRecord* record) {
+    SyncHash slots, location, motion, health, targets, state, random, weapons;
+    for (auto o : SpaceObject::all()) {
+        if (!o->active) {
+            continue;
+        }
+        slots.add(o.number());
+        slots.add(o->id);
+        slots.add(o->active);
+        slots.add(o->base.number());
+        slots.add(o->owner.number());
+
+        location.add(o->location.h);
+        location.add(o->location.v);
+
+        motion.add(o->velocity.h.val());
+        motion.add(o->velocity.v.val());
+        motion.add(o->motionFraction.h.val());
+        motion.add(o->motionFraction.v.val());
+        motion.add(o->thrust.val());
+        motion.add(o->maxVelocity.val());
+        motion.add(o->direction);
+        motion.add(o->turnVelocity.val());
+        motion.add(o->turnFraction.val());
+
+        health.add(o->health());
+        health.add(o->energy());
+        health.add(o->battery());
+
+        targets.add(o->targetObject.number());
+        targets.add(o->targetObjectID);
+        targets.add(o->destObject.number());
+        targets.add(o->destObjectID);
+        targets.add(o->destinationLocation.h);
+        targets.add(o->destinationLocation.v);
+        targets.add(o->closestObject.number());
+        targets.add(o->directionGoal);
+        targets.add(o->targetAngle);
+
+        state.add(o->attributes);
+        state.add(o->runTimeFlags);
+        state.add(o->keysDown);
+        state.add(o->presenceState);
+        state.add(o->duty);
+        state.add(o->cloakState);
+        state.add(o->offlineTime);
+        state.add(o->expire_after.count());
+
+        random.add(o->randomSeed.seed);
+
+        for (const SpaceObject::Weapon* w : {&o->pulse, &o->beam, &o->special}) {
+            weapons.add(w->base.number());
+            weapons.add(w->time.time_since_epoch().count());
+            weapons.add(w->ammo);
+            weapons.add(w->charge);
+        }
+    }
+    record->hashes[SyncRecord::OBJECT_SLOTS]    = slots.value();
+    record->hashes[SyncRecord::OBJECT_LOCATION] = location.value();
+    record->hashes[SyncRecord::OBJECT_MOTION]   = motion.value();
+    record->hashes[SyncRecord::OBJECT_HEALTH]   = health.value();
+    record->hashes[SyncRecord::OBJECT_TARGETS]  = targets.value();
+    record->hashes[SyncRecord::OBJECT_STATE]    = state.value();
+    record->hashes[SyncRecord::OBJECT_RANDOM]   = random.value();
+    record->hashes[SyncRecord::OBJECT_WEAPONS]  = weapons.value();
+}
+
+static uint32_t hash_admirals() {
+    SyncHash hash;
+    for (auto a : Admiral::all()) {
+        if (!a->active()) {
+            continue;
+        }
+        hash.add(a.number());
+        hash.add(a->attributes());
+        hash.add(a->cash().val());
+        hash.add(a->saveGoal().val());
+        hash.add(a->earning_power().val());
+        hash.add(a->kills());
+        hash.add(a->losses());
+        hash.add(a->shipsLeft());
+        for (int i = 0; i < kAdmiralScoreNum; ++i) {
+            hash.add(a->score()[i]);
+        }
+        hash.add(a->blitzkrieg());
+        hash.add(a->considerShip().number());
+        hash.add(a->buildAtObject().number());
+        hash.add(a->hopeToBuild());
+        hash.add(a->control().number());
+        hash.add(a->target().number());
+    }
+    return hash.value();
+}
+
+static uint32_t hash_destinations() {
+    SyncHash hash;
+    for (auto d : Destination::all()) {
+        if (!d->whichObject.get()) {
+            continue;
+        }
+        hash.add(d.number());
+        hash.add(d->whichObject.number());
+        for (int i = 0; i < kMaxPlayerNum; ++i) {
+            hash.add(d->occupied[i]);
+        }
+        hash.add(d->earn.val());
+        hash.add(d->buildTime.count());
+        hash.add(d->totalBuildTime.count());
+        hash.add(d->buildObjectBaseNum.number());
+    }
+    return hash.value();
+}
+
+SyncRecord SyncRecord::current() {
+    SyncRecord record;
+    record.tick = g.time.time_since_epoch().count();
+
+    SyncHash time, random, action_queue;
+    time.add(record.tick);
+    random.add(g.random.seed);
+    hash_action_queue(&action_queue);
+
+    record.hashes[TIME]   = time.value();
+    record.hashes[RANDOM] = random.value();
+    hash_objects(&record);
+    record.hashes[ADMIRALS]     = hash_admirals();
+    record.hashes[DESTINATIONS] = hash_destinations();
+    record.hashes[ACTION_QUEUE] = action_queue.value();
+    return record;
+}
+
+pn::string_view SyncRecord::field_name(int field) {
+    switch (field) {
+        case TIME: return "time";
+        case RANDOM: return "random";
+        case OBJECT_SLOTS: return "object.slots";
+        case OBJECT_LOCATION: return "object.location";
+        case OBJECT_MOTION: return "object.motion";
+        case OBJECT_HEALTH: return "object.health";
+        case OBJECT_TARGETS: return "object.targets";
+        case OBJECT_STATE: return "object.state";
+        case OBJECT_RANDOM: return "object.random";
+        case OBJECT_WEAPONS: return "object.weapons";
+        case ADMIRALS: return "admirals";
+        case DESTINATIONS: return "destinations";
+        case ACTION_QUEUE: return "action-queue";
+    }
+    return "unknown";
+}
+
+SyncTrace::~SyncTrace() {}
+
+SyncTraceWriter::SyncTraceWriter(pn::string_view path) : _file(pn::open(path, "w")) {
+    if (!_file) {
+        throw std::runtime_error(pn::format("{0}: couldn't open sync trace", path).c_str());
+    }
+    const uint8_t field_count = SyncRecord::FIELD_COUNT;
+    _file.write(pn::data_view{reinterpret_cast<const uint8_t*>(kSyncTraceMagic), 8});
+    _file.write(pn::data_view{&field_count, 1});
+}
+
+void SyncTraceWriter::record(const SyncRecord& record) {
+    uint64_t delta = record.tick - _last_tick;
+    _last_tick     = record.tick;
+
+    uint8_t bytes[10 + (4 * SyncRecord::FIELD_COUNT)];
+    int     size = 0;
+    do {
+        bytes[size] = delta & 0x7f;
+        delta >>= 7;
+        if (delta) {
+            bytes[size] |= 0x80;
+        }
+        ++size;
+    } while (delta);
+    for (uint32_t hash : record.hashes) {
+        bytes[size++] = hash >> 24;
+        bytes[size++] = hash >> 16;
+        bytes[size++] = hash >> 8;
+        bytes[size++] = hash;
+    }
+    _file.write(pn::data_view{bytes, size});
+}
+
+static bool read_record(pn::file_view in, int64_t last_tick, SyncRecord* record) {
+    uint64_t delta = 0;
+    for (int shift = 0;; shift += 7) {
+        uint8_t byte;
+        if ((shift >= 64) || (fread(&byte, 1, 1, in.c_obj()) != 1)) {
+            return false;
+        }
+        delta |= uint64_t(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) {
+            break;
+        }
+    }
+    record->tick = last_tick + delta;
+
+    uint8_t bytes[4 * SyncRecord::FIELD_COUNT];
+    if (fread(bytes, 1, sizeof(bytes), in.c_obj()) != sizeof(bytes)) {
+        return false;
+    }
+    for (int i = 0; i < SyncRecord::FIELD_COUNT; ++i) {
+        const uint8_t* b  = &bytes[i * 4];
+        record->hashes[i] = (uint32_t(b[0]) << 24) | (uint32_t(b[1]) << 16) |
+                            (uint32_t(b[2]) << 8) | uint32_t(b[3]);
+    }
+    return true;
+}
+
+SyncTraceVerifier::SyncTraceVerifier(pn::string_view path) {
+    pn::file file = pn::open(path, "r");
+    if (!file) {
+        throw std::runtime_error(pn::format("{0}: couldn't open sync trace", path).c_str());
+    }
+    char    magic[8];
+    uint8_t field_count;
+    if ((fread(magic, 1, 8, file.c_obj()) != 8) || (memcmp(magic, kSyncTraceMagic, 8) != 0) ||
+        (fread(&field_count, 1, 1, file.c_obj()) != 1) ||
+        (field_count != SyncRecord::FIELD_COUNT)) {
+        throw std::runtime_error(pn::format("{0}: not a sync trace", path).c_str());
+    }
+
+    SyncRecord record;
+    int64_t    last_tick = 0;
+    while (read_record(file, last_tick, &record)) {
+        _golden.push_back(record);
+        last_tick = record.tick;
+    }
+}
+
+void SyncTraceVerifier::record(const SyncRecord& record) {
+    if (_diverged) {
+        return;
+    }
+    if (_checked == _golden.size()) {
+        _diverged = true;
+        _tick     = record.tick;
+        _field    = pn::string_view("end of trace").copy();
+        return;
+    }
+    const SyncRecord& golden = _golden[_checked++];
+    if (golden.tick != record.tick) {
+        _diverged = true;
+        _tick     = std::min(golden.tick, record.tick);
+        _field    = SyncRecord::field_name(SyncRecord::TIME).copy();
+        return;
+    }
+    for (int i = 0; i < SyncRecord::FIELD_COUNT; ++i) {
+        if (golden.hashes[i] != record.hashes[i]) {
+            _diverged = true;
+            _tick     = record.tick;
+            _field    = SyncRecord::field_name(i).copy();
+            return;
+        }
+    }
+}
+
+bool SyncTraceVerifier::in_sync() const {
+    return !_diverged && (_checked == _golden.size());
+}
+
+pn::string SyncTraceVerifier::report() const {
+    if (_diverged) {
+        return pn::format("diverged at tick {0}: {1}", _tick, _field);
+    } else if (_checked < _golden.size()) {
+        return pn::format(
+                "ended at tick {0}, before trace did",
+                _checked ? _golden[_checked - 1].tick : int64_t(0));
+    }
+    return pn::format("in sync for {0} major ticks", int64_t(_checked));
+}
+
+void set_sync_trace(SyncTrace* trace) { gSyncTrace = trace; }
+
+void trace_sync() {
+    if (gSyncTrace) {
+        gSyncTrace->record(SyncRecord::current());
+    }
+}
+
+}  // namespace antares
@@ -83,6 +83,13 @@ void Vectors::reset() {
     }
 }
 
+void Vectors::copy_all(const GlobalState& from, GlobalState* to) {
+    if (!to->vectors) {
+        to->vectors.reset(new Vector[Vector::size]);
+    }
+    std::copy(from.vectors.get(), from.vectors.get() + Vector::size, to->vectors.get());
+}
+
 Handle<Vector> Vectors::add(
         coordPointType* location, uint8_t color, uint8_t kind, int32_t accuracy,
         int32_t vector_range) {
@@ -99,6 +106,8 @@ Handle<Vector> Vectors::add(
             const int32_t v      = scale(location->v - gGlobalCorner.v, gAbsoluteScale);
             vector->thisLocation = Rect(0, 0, 0, 0);
             vector->thisLocation.offset(h + viewport().left, v + viewport().top);
+            vector->lastLocation = vector->thisLocation;
+            vector->located      = false;
 
             vector->vectorKind      = kind;
             vector->accuracy        = accuracy;
@@ -174,6 +183,7 @@ void Vectors::set_attributes(Handle<SpaceObject> vectorObject, Handle<SpaceObjec
 void Vectors::update() {
     for (auto vector : Vector::all()) {
         if (vector->active) {
+            const Rect previous = vector->thisLocation;
             if (vector->lastApparentLocation != vector->objectLocation) {
                 vector->thisLocation = Rect(
                         scale(vector->objectLocation.h - gGlobalCorner.h, gAbsoluteScale),
@@ -183,6 +193,8 @@ void Vectors::update() {
                 vector->thisLocation.offset(viewport().left, viewport().top);
                 vector->lastApparentLocation = vector->objectLocation;
             }
+            vector->lastLocation = vector->located ? previous : vector->thisLocation;
+            vector->located      = true;
 
             if (!vector->killMe) {
                 if (vector->color) {
@@ -226,24 +238,41 @@ void Vectors::update() {
     }
 }
 
-void Vectors::draw() {
+void Vectors::draw(int32_t progress) {
     Lines lines;
     for (auto vector : Vector::all()) {
         if (vector->active) {
             if (!vector->killMe) {
                 if (vector->color) {
+                    const Rect& last = vector->lastLocation;
+                    const Rect& now  = vector->thisLocation;
+                    const Point from = interpolate(
+                            Point(last.left, last.top), Point(now.left, now.top), progress);
+                    const Point to = interpolate(
+                            Point(last.right, last.bottom), Point(now.right, now.bottom),
+                            progress);
                     if ((vector->vectorKind == Vector::BEAM_TO_OBJECT_LIGHTNING) ||
                         (vector->vectorKind == Vector::BEAM_TO_COORD_LIGHTNING)) {
+                        // The bolt's points are shifted along with its ends, by an amount that
+                        // runs from the shift of its start to the shift of its end.
+                        Point points[kBoltPointNum];
+                        for (int j : range(kBoltPointNum)) {
+                            const int32_t dh = ((from.h - now.left) * (kBoltPointNum - 1 - j) +
+                                                (to.h - now.right) * j) /
+                                               (kBoltPointNum - 1);
+                            const int32_t dv = ((from.v - now.top) * (kBoltPointNum - 1 - j) +
+                                                (to.v - now.bottom) * j) /
+                                               (kBoltPointNum - 1);
+                            points[j] = vector->thisBoltPoint[j];
+                            points[j].offset(dh, dv);
+                        }
                         for (int j : range(1, kBoltPointNum)) {
                             lines.draw(
-                                    vector->thisBoltPoint[j - 1], vector->thisBoltPoint[j],
+                                    points[j - 1], points[j],
                                     GetRGBTranslateColor(vector->color));
                         }
                     } else {
-                        lines.draw(
-                                Point(vector->thisLocation.left, vector->thisLocation.top),
-                                Point(vector->thisLocation.right, vector->thisLocation.bottom),
-                                GetRGBTranslateColor(vector->color));
+                        lines.draw(from, to, GetRGBTranslateColor(vector->color));
                     }
                 }
             }
@@ -0,0 +1,137 @@
+// Copyright (C) 1997, 1999-2001, 2008 Nathan Lamont
+// Copyright (C) 2008-2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#include "game/workers.hpp"
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "lang/defines.hpp"
+
+namespace antares {
+
+namespace {
+
+class WorkerPool {
+  public:
+    explicit WorkerPool(int threads) {
+        for (int i = 1; i < threads; ++i) {
+            _threads.emplace_back([this] { work(); });
+        }
+    }
+
+    ~WorkerPool() {
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _exit = true;
+        }
+        _wake.notify_all();
+        for (auto& t : _threads) {
+            t.join();
+        }
+    }
+
+    int threads() const { return _threads.size() + 1; }
+
+    void run(int count, const std::function<void(int)>& task) {
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _task    = &task;
+            _count   = count;
+            _next    = 0;
+            _running = 0;
+            ++_generation;
+        }
+        _wake.notify_all();
+
+        std::unique_lock<std::mutex> lock(_mutex);
+        drain(lock);
+        _done.wait(lock, [this] { return (_next == _count) && (_running == 0); });
+        _task = nullptr;
+    }
+
+  private:
+    void work() {
+        std::unique_lock<std::mutex> lock(_mutex);
+        int                          seen = 0;
+        while (true) {
+            _wake.wait(lock, [this, seen] { return _exit || (_generation != seen); });
+            if (_exit) {
+                return;
+            }
+            seen = _generation;
+            drain(lock);
+        }
+    }
+
+    // Runs tasks from the current job until none are left to start.  Called with `lock` held;
+    // releases it while each task runs.
+    void drain(std::unique_lock<std::mutex>& lock) {
+        while (_task && (_next < _count)) {
+            const int                       i    = _next++;
+            const std::function<void(int)>& task = *_task;
+            ++_running;
+            lock.unlock();
+            task(i);
+            lock.lock();
+            --_running;
+        }
+        if ((_next == _count) && (_running == 0)) {
+            _done.notify_all();
+        }
+    }
+
+    std::vector<std::thread>        _threads;
+    std::mutex                      _mutex;
+    std::condition_variable         _wake;
+    std::condition_variable         _done;
+    const std::function<void(int)>* _task       = nullptr;
+    int                             _count      = 0;
+    int                             _next       = 0;
+    int                             _running    = 0;
+    int                             _generation = 0;
+    bool                            _exit       = false;
+};
+
+ANTARES_GLOBAL std::unique_ptr<WorkerPool> workers;
+
+}  // namespace
+
+void set_worker_threads(int threads) {
+    workers.reset();
+    if (threads > 1) {
+        workers.reset(new WorkerPool(threads));
+    }
+}
+
+int worker_threads() { return workers ? workers->threads() : 1; }
+
+void parallel_for(int count, const std::function<void(int)>& task) {
+    if (!workers || (count <= 1)) {
+        for (int i = 0; i < count; ++i) {
+            task(i);
+        }
+        return;
+    }
+    workers->run(count, task);
+}
+
+}  // namespace antares
@@ -19,15 +19,19 @@
 #include <GLFW/glfw3.h>
 
 #include <time.h>
+#include <algorithm>
 #include <pn/file>
 #include <sfz/sfz.hpp>
+#include <thread>
 
 #include "config/dirs.hpp"
 #include "config/file-prefs-driver.hpp"
 #include "config/ledger.hpp"
 #include "config/preferences.hpp"
 #include "data/scenario-list.hpp"
+#include "drawing/sprite-handling.hpp"
 #include "game/sys.hpp"
+#include "game/workers.hpp"
 #include "glfw/video-driver.hpp"
 #include "sound/openal-driver.hpp"
 #include "ui/flows/master.hpp"
@@ -39,6 +43,8 @@ namespace args = sfz::args;
 namespace antares {
 namespace {
 
+int default_threads() { return std::max(1u, std::thread::hardware_concurrency()); }
+
 void usage(pn::file_view out, pn::string_view progname, int retcode) {
     pn::format(
             out,
@@ -54,8 +60,14 @@ void usage(pn::file_view out, pn::string_view progname, int retcode) {
             "                        (default: {1})\n"
             "    -f, --factory       set path to factory scenario\n"
             "                        (default: {2})\n"
-            "    -h, --help          display this help screen\n",
-            progname, default_application_path(), default_factory_scenario_path());
+            "    -h, --help          display this help screen\n"
+            "    -t, --threads=N     loading and simulation threads\n"
+            "                        (default: {3})\n"
+            "        --vsync         draw a frame for each refresh of the display\n"
+            "        --interpolate   smooth motion between ticks (implies --vsync)\n"
+            "        --frame-times   print a histogram of frame times on exit\n",
+            progname, default_application_path(), default_factory_scenario_path(),
+            default_threads());
     exit(retcode);
 }
 
@@ -74,28 +86,45 @@ void main(int argc, char* const* argv) {
         return true;
     };
 
-    callbacks.short_option = [&progname](
+    int threads            = default_threads();
+    callbacks.short_option = [&progname, &threads](
                                      pn::rune opt, const args::callbacks::get_value_f& get_value) {
         switch (opt.value()) {
             case 'a': set_application_path(get_value()); return true;
             case 'f': set_factory_scenario_path(get_value()); return true;
             case 'h': usage(stdout, progname, 0); return true;
+            case 't': args::integer_option(get_value(), &threads); return true;
             default: return false;
         }
     };
 
-    callbacks.long_option =
-            [&callbacks](pn::string_view opt, const args::callbacks::get_value_f& get_value) {
-                if (opt == "app-data") {
-                    return callbacks.short_option(pn::rune{'a'}, get_value);
-                } else if (opt == "factory-scenario") {
-                    return callbacks.short_option(pn::rune{'f'}, get_value);
-                } else if (opt == "help") {
-                    return callbacks.short_option(pn::rune{'h'}, get_value);
-                } else {
-                    return false;
-                }
-            };
+    bool vsync       = false;
+    bool interpolate = false;
+    bool frame_times = false;
+    callbacks.long_option = [&callbacks, &vsync, &interpolate, &frame_times](
+                                    pn::string_view                     opt,
+                                    const args::callbacks::get_value_f& get_value) {
+        if (opt == "app-data") {
+            return callbacks.short_option(pn::rune{'a'}, get_value);
+        } else if (opt == "factory-scenario") {
+            return callbacks.short_option(pn::rune{'f'}, get_value);
+        } else if (opt == "help") {
+            return callbacks.short_option(pn::rune{'h'}, get_value);
+        } else if (opt == "threads") {
+            return callbacks.short_option(pn::rune{'t'}, get_value);
+        } else if (opt == "vsync") {
+            vsync = true;
+            return true;
+        } else if (opt == "interpolate") {
+            interpolate = true;
+            return true;
+        } else if (opt == "frame-times") {
+            frame_times = true;
+            return true;
+        } else {
+            return false;
+        }
+    };
 
     args::parse(argc - 1, argv + 1, callbacks);
 
@@ -156,10 +185,16 @@ void main(int argc, char* const* argv) {
         }
     }
 
+    set_worker_threads(threads);
     DirectoryLedger   ledger;
     OpenAlSoundDriver sound;
     GLFWVideoDriver   video;
+    set_draw_interpolation(interpolate);
+    video.set_vsync(vsync || interpolate);
     video.loop(new Master(time(NULL)));
+    if (frame_times) {
+        pn::format(stderr, "{0}", video.frame_times());
+    }
 }
 
 void print_nested_exception(const std::exception& e) {
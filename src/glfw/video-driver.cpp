@@ -20,7 +20,7 @@
 
 #include <GLFW/glfw3.h>
 #include <sys/time.h>
-#include <unistd.h>
+#include <algorithm>
 #include <pn/file>
 #include <sfz/sfz.hpp>
 
@@ -175,6 +175,7 @@ void GLFWVideoDriver::key(int key, int scancode, int action, int mods) {
     if (!key) {
         return;
     }
+    _dirty = true;
     if (action == GLFW_PRESS) {
         KeyDownEvent(now(), key).send(_loop->top());
     } else if (action == GLFW_RELEASE) {
@@ -185,6 +186,7 @@ void GLFWVideoDriver::key(int key, int scancode, int action, int mods) {
 }
 
 void GLFWVideoDriver::mouse_button(int button, int action, int mods) {
+    _dirty = true;
     if (action == GLFW_PRESS) {
         if (now() <= (_last_click_usecs + kDoubleClickInterval)) {
             _last_click_count += 1;
@@ -201,12 +203,14 @@ void GLFWVideoDriver::mouse_button(int button, int action, int mods) {
 }
 
 void GLFWVideoDriver::mouse_move(double x, double y) {
+    _dirty = true;
     MouseMoveEvent(now(), Point(x, y)).send(_loop->top());
 }
 
 void GLFWVideoDriver::window_size(int width, int height) {
     _screen_size = {width, height};
     glfwGetFramebufferSize(_window, &_viewport_size.width, &_viewport_size.height);
+    _dirty = true;
 }
 
 void GLFWVideoDriver::key_callback(GLFWwindow* w, int key, int scancode, int action, int mods) {
@@ -229,6 +233,48 @@ void GLFWVideoDriver::window_size_callback(GLFWwindow* w, int width, int height)
     driver->window_size(width, height);
 }
 
+void GLFWVideoDriver::window_refresh_callback(GLFWwindow* w) {
+    GLFWVideoDriver* driver = reinterpret_cast<GLFWVideoDriver*>(glfwGetWindowUserPointer(w));
+    driver->_dirty          = true;
+}
+
+void GLFWVideoDriver::draw_frame() {
+    const wall_time start = now();
+    _last_frame           = start;
+    _loop->draw();
+    glfwSwapBuffers(_window);
+    _dirty = false;
+
+    const int64_t ms     = std::chrono::duration_cast<usecs>(now() - start).count() / 1000;
+    int           bucket = 0;
+    while ((bucket < (kFrameTimeBuckets - 1)) && (ms >= (int64_t(1) << bucket))) {
+        ++bucket;
+    }
+    ++_frame_times[bucket];
+}
+
+pn::string GLFWVideoDriver::frame_times() const {
+    int64_t frames = 0;
+    for (int64_t count : _frame_times) {
+        frames += count;
+    }
+    pn::string result = pn::format("frames: {0}\n", frames);
+    if (frames > 0) {
+        result += pn::format(
+                "draw calls: {0} ({1} per frame)\n", draw_calls(), draw_calls() / frames);
+    }
+    for (int i = 0; i < kFrameTimeBuckets; ++i) {
+        if (i == 0) {
+            result += pn::format("  <1 ms: {0}\n", _frame_times[i]);
+        } else if (i < (kFrameTimeBuckets - 1)) {
+            result += pn::format("  <{0} ms: {1}\n", 1 << i, _frame_times[i]);
+        } else {
+            result += pn::format("  >={0} ms: {1}\n", 1 << (i - 1), _frame_times[i]);
+        }
+    }
+    return result;
+}
+
 void GLFWVideoDriver::loop(Card* initial) {
     /* Create a windowed mode window and its OpenGL context */
     glfwWindowHint(GLFW_CLIENT_API, GLFW_OPENGL_API);
@@ -248,25 +294,54 @@ void GLFWVideoDriver::loop(Card* initial) {
     glfwSetMouseButtonCallback(_window, mouse_button_callback);
     glfwSetCursorPosCallback(_window, mouse_move_callback);
     glfwSetWindowSizeCallback(_window, window_size_callback);
+    glfwSetWindowRefreshCallback(_window, window_refresh_callback);
 
     /* Make the _window's context current */
     glfwMakeContextCurrent(_window);
+    glfwSwapInterval(_vsync ? 1 : 0);
+    const GLFWvidmode* mode    = glfwGetVideoMode(glfwGetPrimaryMonitor());
+    const int          refresh = (mode && (mode->refreshRate > 0)) ? mode->refreshRate : 60;
+    _refresh_interval          = usecs(1000000 / refresh);
 
     MainLoop main_loop(*this, initial);
     _loop = &main_loop;
-    main_loop.draw();
+    draw_frame();
 
     while (!main_loop.done() && !glfwWindowShouldClose(_window)) {
-        glfwPollEvents();
-        _loop->draw();
-        glfwSwapBuffers(_window);
         wall_time at;
-        if (main_loop.top()->next_timer(at) && (now() > at)) {
-            main_loop.top()->fire_timer();
-            main_loop.draw();
-            glfwSwapBuffers(_window);
+        if (_vsync) {
+            // Block until the next refresh, unless input or a timer arrives first.  The swap in
+            // draw_frame() then only has to wait out whatever is left of the refresh.
+            const wall_time refresh = _last_frame + _refresh_interval;
+            wall_time       until   = refresh;
+            if (main_loop.top()->next_timer(at)) {
+                until = std::min(until, at);
+            }
+            if (now() < until) {
+                glfwWaitEventsTimeout(std::chrono::duration<double>(until - now()).count());
+            } else {
+                glfwPollEvents();
+            }
+            if (now() >= refresh) {
+                _dirty = true;
+            }
+        } else if (!main_loop.top()->next_timer(at)) {
+            glfwWaitEvents();
+        } else if (now() < at) {
+            glfwWaitEventsTimeout(std::chrono::duration<double>(at - now()).count());
         } else {
-            usleep(10);
+            glfwPollEvents();
+        }
+        if (main_loop.done()) {
+            break;
+        }
+
+        if (main_loop.top()->next_timer(at) && (now() >= at)) {
+            main_loop.top()->fire_timer();
+            _dirty = true;
+        }
+        if (_dirty && !main_loop.done()) {
+            draw_frame();
         }
     }
 }
@@ -16,10 +16,11 @@
 // You should have received a copy of the GNU Lesser General Public
 // License along with Antares.  If not, see http://www.gnu.org/licenses/
 
-#include <limits>
-
 #include "math/special.hpp"
 
+#include <limits>
+#include <vector>
+
 namespace antares {
 
 //      FOR THE SQUARE ROOT CODE:
@@ -210,38 +211,14 @@ uint64_t wsqrt(uint64_t n) {
     return implicit_cast<uint64_t>(lsqrt(n)) << root_correction;
 }
 
+// Returns numer/denom as a Fixed, truncated towards zero.  Dividing by zero gives the largest
+// value with the sign of `numer`.  The quotient is worked out in 64 bits, so -32768/-1 wraps
+// around instead of trapping.
 Fixed MyFixRatio(int16_t numer, int16_t denom) {
-    int32_t longdenom, result;
-
-    longdenom = denom;
-    if (!longdenom) {
-        goto label1;
+    if (!denom) {
+        return Fixed::from_val((numer >= 0) ? 0x7fffffff : -0x7fffffff);
     }
-
-    result = numer;
-    result &= 0x0000ffff;
-    if (numer == denom) {
-        goto label3;
-    }
-
-    result = ((result >> 16L) & 0x0000ffff) | ((result << 16L) & 0xffff0000);
-    result /= longdenom;
-    return Fixed::from_val(result);
-
-label1:
-    result = 0x7fffffff;
-    if (numer >= 0) {
-        goto label2;
-    }
-    result = -result;
-
-label2:
-    return Fixed::from_val(result);
-
-label3:
-    result = 0x00000001;
-    result = ((result >> 16L) & 0x0000ffff) | ((result << 16L) & 0xffff0000);
-    return Fixed::from_val(result);
+    return Fixed::from_val(static_cast<int32_t>((int64_t{numer} * 65536) / denom));
 }
 
 int16_t ratio_to_angle(Fixed x, Fixed y) {
@@ -459,13 +436,41 @@ static const AngleFromSlopeData angle_from_slope_data[angle_from_slope_data_coun
         {3755045, 90},
 };
 
-int32_t AngleFromSlope(Fixed slope) {
-    for (int i = 1; i < angle_from_slope_data_count; ++i) {
-        if (angle_from_slope_data[i].min_slope > slope.val()) {
-            return angle_from_slope_data[i - 1].angle;
+// Rather than search angle_from_slope_data for the first row past `slope`, AngleFromSlope()
+// starts from an index with one entry per 2^kSlopeIndexShift slopes, which gives the row
+// matching the first slope in each range.  Rows are at least 500 apart, so it then checks at most
+// two more.
+static const int kSlopeIndexShift = 9;
+
+static const uint8_t* angle_from_slope_index() {
+    static const std::vector<uint8_t> index = [] {
+        const int32_t min = angle_from_slope_data[1].min_slope;
+        const int32_t max = angle_from_slope_data[angle_from_slope_data_count - 1].min_slope;
+
+        std::vector<uint8_t> index;
+        uint8_t              row = 0;
+        for (int64_t slope = min; slope < max; slope += (1 << kSlopeIndexShift)) {
+            while (angle_from_slope_data[row + 1].min_slope <= slope) {
+                ++row;
+            }
+            index.push_back(row);
         }
+        return index;
+    }();
+    return index.data();
+}
+
+int32_t AngleFromSlope(Fixed slope) {
+    const int32_t min = angle_from_slope_data[1].min_slope;
+    const int32_t max = angle_from_slope_data[angle_from_slope_data_count - 1].min_slope;
+    if ((slope.val() < min) || (slope.val() >= max)) {
+        return 90;
+    }
+    int row = angle_from_slope_index()[(int64_t{slope.val()} - min) >> kSlopeIndexShift];
+    while (angle_from_slope_data[row + 1].min_slope <= slope.val()) {
+        ++row;
     }
-    return 90;
+    return angle_from_slope_data[row].angle;
 }
 
 }  // namespace antares
@@ -43,6 +43,10 @@ SoundDriver::SoundDriver() {
 
 SoundDriver::~SoundDriver() { sys.audio = NULL; }
 
+unique_ptr<Sound> SoundDriver::open_sound(pn::string_view path) {
+    return open_sound(decode_sound(path));
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 // NullSoundDriver
 
@@ -73,8 +77,13 @@ unique_ptr<SoundChannel> NullSoundDriver::open_channel() {
     return unique_ptr<SoundChannel>(new NullChannel);
 }
 
-unique_ptr<Sound> NullSoundDriver::open_sound(pn::string_view path) {
+unique_ptr<DecodedSound> NullSoundDriver::decode_sound(pn::string_view path) {
     static_cast<void>(path);
+    return unique_ptr<DecodedSound>(new DecodedSound);
+}
+
+unique_ptr<Sound> NullSoundDriver::open_sound(unique_ptr<DecodedSound> decoded) {
+    static_cast<void>(decoded);
     return unique_ptr<Sound>(new NullSound);
 }
 
@@ -132,6 +141,13 @@ class LogSoundDriver::LogSound : public Sound {
     const pn::string      _path;
 };
 
+class LogSoundDriver::LogDecodedSound : public DecodedSound {
+  public:
+    LogDecodedSound(pn::string_view path) : path(path.copy()) {}
+
+    const pn::string path;
+};
+
 LogSoundDriver::LogSoundDriver(pn::string_view path)
         : _sound_log(pn::open(path, "w")), _last_id(-1), _active_channel(NULL) {}
 
@@ -139,8 +155,13 @@ unique_ptr<SoundChannel> LogSoundDriver::open_channel() {
     return unique_ptr<SoundChannel>(new LogChannel(*this));
 }
 
-unique_ptr<Sound> LogSoundDriver::open_sound(pn::string_view path) {
-    return unique_ptr<Sound>(new LogSound(*this, path));
+unique_ptr<DecodedSound> LogSoundDriver::decode_sound(pn::string_view path) {
+    return unique_ptr<DecodedSound>(new LogDecodedSound(path));
+}
+
+unique_ptr<Sound> LogSoundDriver::open_sound(unique_ptr<DecodedSound> decoded) {
+    const LogDecodedSound& log = static_cast<const LogDecodedSound&>(*decoded);
+    return unique_ptr<Sound>(new LogSound(*this, log.path));
 }
 
 void LogSoundDriver::set_global_volume(uint8_t volume) { static_cast<void>(volume); }
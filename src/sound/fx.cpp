@@ -222,15 +222,29 @@ void SoundFX::reset() {
 }
 
 void SoundFX::load(int16_t id) {
-    int whichSound = 0;
-    while ((whichSound < sounds.size()) && (sounds[whichSound].id != id)) {
-        whichSound++;
+    if (!loaded(id)) {
+        insert(id, decode(id));
     }
+}
+
+bool SoundFX::loaded(int16_t id) const {
+    for (const auto& sound : sounds) {
+        if (sound.id == id) {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::unique_ptr<DecodedSound> SoundFX::decode(int16_t id) {
+    return sys.audio->decode_sound(pn::format("/sounds/{0}", id));
+}
 
-    if (whichSound == sounds.size()) {
+void SoundFX::insert(int16_t id, std::unique_ptr<DecodedSound> decoded) {
+    if (!loaded(id)) {
         sounds.emplace_back();
         sounds.back().id          = id;
-        sounds.back().soundHandle = sys.audio->open_sound(pn::format("/sounds/{0}", id));
+        sounds.back().soundHandle = sys.audio->open_sound(std::move(decoded));
     }
 }
 
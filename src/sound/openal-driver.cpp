@@ -19,9 +19,11 @@
 #include "sound/openal-driver.hpp"
 
 #include <libmodplug/modplug.h>
+#include <mutex>
 #include <pn/file>
 
 #include "data/resource.hpp"
+#include "lang/defines.hpp"
 #include "sound/sndfile.hpp"
 
 using std::unique_ptr;
@@ -50,9 +52,12 @@ void check_al_error(pn::string_view method) {
     }
 }
 
+// ModPlug's settings and mixer state are global, so only one file can be used at a time.
+ANTARES_GLOBAL std::mutex modplug_mutex;
+
 class ModPlugFile {
   public:
-    ModPlugFile(pn::data_view data) {
+    ModPlugFile(pn::data_view data) : lock(modplug_mutex) {
         ModPlug_Settings settings;
         ModPlug_GetSettings(&settings);
         settings.mFlags          = MODPLUG_ENABLE_OVERSAMPLING;
@@ -84,7 +89,8 @@ class ModPlugFile {
     }
 
   private:
-    ::ModPlugFile* file;
+    std::unique_lock<std::mutex> lock;
+    ::ModPlugFile*               file;
 };
 
 }  // namespace
@@ -101,15 +107,7 @@ class OpenAlSoundDriver::OpenAlSound : public Sound {
     virtual void play();
     virtual void loop();
 
-    template <typename T>
-    void buffer(const T& file) {
-        pn::data data;
-        ALenum   format;
-        ALsizei  frequency;
-        file.convert(data, format, frequency);
-        alBufferData(_buffer, format, data.data(), data.size(), frequency);
-        check_al_error("alBufferData");
-    }
+    void buffer(const OpenAlDecodedSound& decoded);
 
     ALuint buffer() const { return _buffer; }
 
@@ -175,6 +173,19 @@ class OpenAlSoundDriver::OpenAlChannel : public SoundChannel {
     ALuint             _source;
 };
 
+class OpenAlSoundDriver::OpenAlDecodedSound : public DecodedSound {
+  public:
+    pn::data data;
+    ALenum   format;
+    ALsizei  frequency;
+};
+
+void OpenAlSoundDriver::OpenAlSound::buffer(const OpenAlDecodedSound& decoded) {
+    alBufferData(
+            _buffer, decoded.format, decoded.data.data(), decoded.data.size(), decoded.frequency);
+    check_al_error("alBufferData");
+}
+
 void OpenAlSoundDriver::OpenAlSound::play() { _driver._active_channel->play(*this); }
 
 void OpenAlSoundDriver::OpenAlSound::loop() { _driver._active_channel->loop(*this); }
@@ -196,25 +207,25 @@ unique_ptr<SoundChannel> OpenAlSoundDriver::open_channel() {
 }
 
 template <typename T>
-void OpenAlSoundDriver::read_sound(pn::data_view data, OpenAlSound& sound) {
+void OpenAlSoundDriver::read_sound(pn::data_view data, OpenAlDecodedSound& sound) {
     T file(data);
-    sound.buffer(file);
+    file.convert(sound.data, sound.format, sound.frequency);
 }
 
-unique_ptr<Sound> OpenAlSoundDriver::open_sound(pn::string_view path) {
+unique_ptr<DecodedSound> OpenAlSoundDriver::decode_sound(pn::string_view path) {
     static const struct {
         const char ext[6];
-        void (*fn)(pn::data_view, OpenAlSound&);
+        void (*fn)(pn::data_view, OpenAlDecodedSound&);
     } fmts[] = {
             {".aiff", read_sound<Sndfile>},
             {".s3m", read_sound<ModPlugFile>},
             {".xm", read_sound<ModPlugFile>},
     };
 
-    unique_ptr<OpenAlSound> sound(new OpenAlSound(*this));
     for (const auto& fmt : fmts) {
         try {
-            Resource rsrc(pn::format("{0}{1}", path, fmt.ext));
+            unique_ptr<OpenAlDecodedSound> sound(new OpenAlDecodedSound);
+            Resource                       rsrc(pn::format("{0}{1}", path, fmt.ext));
             fmt.fn(rsrc.data(), *sound);
             return std::move(sound);
         } catch (std::exception& e) {
@@ -225,6 +236,12 @@ unique_ptr<Sound> OpenAlSoundDriver::open_sound(pn::string_view path) {
             pn::format("couldn't load sound {0}", pn::dump(path, pn::dump_short)).c_str());
 }
 
+unique_ptr<Sound> OpenAlSoundDriver::open_sound(unique_ptr<DecodedSound> decoded) {
+    unique_ptr<OpenAlSound> sound(new OpenAlSound(*this));
+    sound->buffer(static_cast<const OpenAlDecodedSound&>(*decoded));
+    return std::move(sound);
+}
+
 void OpenAlSoundDriver::set_global_volume(uint8_t volume) { alListenerf(AL_GAIN, volume / 8.0); }
 
 }  // namespace antares
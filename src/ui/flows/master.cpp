@@ -119,9 +119,9 @@ void Master::init() {
     Label::init();
     Messages::init();
     InstrumentInit();
-    SpriteHandlingInit();
+    SpriteHandlingInit(kMaxSprite);
     PluginInit();
-    SpaceObjectHandlingInit();  // MUST be after ScenarioMakerInit()
+    SpaceObjectHandlingInit(kMaxSpaceObject);  // MUST be after ScenarioMakerInit()
     InitMotion();
     Admiral::init();
     Vectors::init();
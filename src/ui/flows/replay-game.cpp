@@ -54,7 +54,7 @@ void ReplayGame::become_front() {
             _state = PLAYING;
             swap(_random_seed, g.random);
             _game_result = NO_GAME;
-            stack()->push(new MainPlay(_level, true, &_input_source, true, &_game_result));
+            stack()->push(new MainPlay(_level, true, &_input_source, true, false, &_game_result));
         } break;
 
         case PLAYING:
@@ -73,7 +73,7 @@ void SoloGame::become_front() {
         case RESTART_LEVEL:
             _state       = PLAYING;
             _game_result = NO_GAME;
-            stack()->push(new MainPlay(_level, false, &_input_source, true, &_game_result));
+            stack()->push(new MainPlay(_level, false, &_input_source, true, false, &_game_result));
             break;
 
         case PLAYING: handle_game_result(); break;
@@ -96,7 +96,7 @@ void InterfaceScreen::draw() const {
     Rects().fill(copy_area, RgbColor::black());
 
     for (const auto& item : _items) {
-        draw_interface_item(*item, sys.video->input_mode(), off);
+        draw_interface_item(*item, sys.video->input_mode(), off, &_texts);
     }
     overlay();
     if (stack()->top() == this) {
@@ -213,6 +213,9 @@ void InterfaceScreen::truncate(size_t size) {
     if (size > _items.size()) {
         throw std::runtime_error("");
     }
+    for (size_t i = size; i < _items.size(); ++i) {
+        _texts.erase(_items[i].get());
+    }
     _items.resize(size);
 }
 
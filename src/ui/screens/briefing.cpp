@@ -459,7 +459,7 @@ void BriefingScreen::draw_brief_point() const {
     draw_interface_item(_data_item, KEYBOARD_MOUSE, off);
     bounds = _data_item.bounds();
     bounds.offset(off.h, off.v);
-    draw_text_in_rect(bounds, _text, _data_item.style, _data_item.hue);
+    _text_layout.draw(bounds, _text, _data_item.style, _data_item.hue);
 }
 
 void BriefingScreen::show_object_data(int index, const KeyDownEvent& event) {
@@ -32,6 +32,12 @@ VideoDriver::VideoDriver() {
 
 VideoDriver::~VideoDriver() { sys.video = NULL; }
 
+Texture VideoDriver::atlas_texture(pn::string_view name, const PixMap& content) {
+    return texture(name, content);
+}
+
+pn::string VideoDriver::atlas_stats() const { return pn::string{}; }
+
 Texture::Impl::~Impl() {}
 
 Points::Points() { sys.video->begin_points(); }
@@ -0,0 +1,101 @@
+// Copyright (C) 1997, 1999-2001, 2008 Nathan Lamont
+// Copyright (C) 2008-2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#include "video/frame-stream.hpp"
+
+#include <stdexcept>
+
+#include "drawing/pix-map.hpp"
+
+namespace antares {
+
+namespace {
+
+const char kFrameHeader[] = "FRAME\n";
+
+// BT.601 studio range, as ffmpeg expects from Y4M by default.
+uint8_t luma(const RgbColor& c) {
+    return (((66 * c.red) + (129 * c.green) + (25 * c.blue) + 128) >> 8) + 16;
+}
+
+uint8_t blue_chroma(const RgbColor& c) {
+    return (((-38 * c.red) - (74 * c.green) + (112 * c.blue) + 128) >> 8) + 128;
+}
+
+uint8_t red_chroma(const RgbColor& c) {
+    return (((112 * c.red) - (94 * c.green) - (18 * c.blue) + 128) >> 8) + 128;
+}
+
+}  // namespace
+
+FrameStream::Format FrameStream::format(pn::string_view name) {
+    if (name == "y4m") {
+        return Y4M;
+    } else if (name == "rgb") {
+        return RGB;
+    }
+    throw std::runtime_error(pn::format("unknown stream format {0}", name).c_str());
+}
+
+FrameStream::FrameStream(pn::file_view out, Format format, Size size, int frame_ticks)
+        : _out(out), _format(format), _size(size) {
+    if (_format == Y4M) {
+        _out.write(pn::format(
+                "YUV4MPEG2 W{0} H{1} F60:{2} Ip A1:1 C444\n", size.width, size.height,
+                frame_ticks));
+    }
+}
+
+pn::data FrameStream::frame(const PixMap& pix) const {
+    const int64_t plane = int64_t(_size.width) * _size.height;
+    pn::data      frame;
+    if (_format == Y4M) {
+        const int64_t header = sizeof(kFrameHeader) - 1;
+        frame.resize(header + (3 * plane));
+        uint8_t* y = frame.data();
+        for (const char* c = kFrameHeader; *c; ++c) {
+            *(y++) = *c;
+        }
+        uint8_t* u = y + plane;
+        uint8_t* v = u + plane;
+        for (int32_t row = 0; row < _size.height; ++row) {
+            const RgbColor* p = pix.row(row);
+            for (int32_t col = 0; col < _size.width; ++col, ++p) {
+                *(y++) = luma(*p);
+                *(u++) = blue_chroma(*p);
+                *(v++) = red_chroma(*p);
+            }
+        }
+    } else {
+        frame.resize(3 * plane);
+        uint8_t* out = frame.data();
+        for (int32_t row = 0; row < _size.height; ++row) {
+            const RgbColor* p = pix.row(row);
+            for (int32_t col = 0; col < _size.width; ++col, ++p) {
+                *(out++) = p->red;
+                *(out++) = p->green;
+                *(out++) = p->blue;
+            }
+        }
+    }
+    return frame;
+}
+
+void FrameStream::write(pn::data_view frame) { _out.write(frame); }
+
+}  // namespace antares
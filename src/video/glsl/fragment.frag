@@ -31,6 +31,7 @@ uniform sampler2D static_image;
 uniform float     static_fraction;
 uniform vec2 unit;
 uniform vec4 outline_color;
+uniform vec4 sprite_bounds;
 uniform int  seed;
 
 const int FILL_MODE           = 0;
@@ -62,14 +63,16 @@ void main() {
             frag_color = sprite_color;
         }
     } else if (color_mode == OUTLINE_SPRITE_MODE) {
-        float neighborhood = texture(sprite, uv + vec2(-unit.s, -unit.t)).w +
-                             texture(sprite, uv + vec2(-unit.s, 0)).w +
-                             texture(sprite, uv + vec2(-unit.s, unit.t)).w +
-                             texture(sprite, uv + vec2(0, -unit.t)).w +
-                             texture(sprite, uv + vec2(0, unit.t)).w +
-                             texture(sprite, uv + vec2(unit.s, -unit.t)).w +
-                             texture(sprite, uv + vec2(unit.s, 0)).w +
-                             texture(sprite, uv + vec2(unit.s, unit.t)).w;
+        vec2  lo           = sprite_bounds.xy;
+        vec2  hi           = sprite_bounds.zw;
+        float neighborhood = texture(sprite, clamp(uv + vec2(-unit.s, -unit.t), lo, hi)).w +
+                             texture(sprite, clamp(uv + vec2(-unit.s, 0), lo, hi)).w +
+                             texture(sprite, clamp(uv + vec2(-unit.s, unit.t), lo, hi)).w +
+                             texture(sprite, clamp(uv + vec2(0, -unit.t), lo, hi)).w +
+                             texture(sprite, clamp(uv + vec2(0, unit.t), lo, hi)).w +
+                             texture(sprite, clamp(uv + vec2(unit.s, -unit.t), lo, hi)).w +
+                             texture(sprite, clamp(uv + vec2(unit.s, 0), lo, hi)).w +
+                             texture(sprite, clamp(uv + vec2(unit.s, unit.t), lo, hi)).w;
         if (sprite_color.w > (neighborhood / 8)) {
             frag_color = outline_color;
         } else if (sprite_color.w > 0) {
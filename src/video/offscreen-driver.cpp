@@ -20,18 +20,28 @@
 
 #include <fcntl.h>
 #include <stdlib.h>
+#include <string.h>
 #include <strings.h>
 #include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
 #include <pn/file>
 #include <sfz/sfz.hpp>
+#include <thread>
+#include <vector>
 
 #include "config/preferences.hpp"
+#include "drawing/pix-kernels.hpp"
 #include "drawing/pix-map.hpp"
 #include "game/sys.hpp"
 #include "game/time.hpp"
 #include "math/geometry.hpp"
 #include "ui/card.hpp"
 #include "ui/event.hpp"
+#include "video/frame-stream.hpp"
 
 #ifdef __APPLE__
 #include <OpenGL/OpenGL.h>
@@ -59,30 +69,211 @@ namespace antares {
 
 namespace {
 
+// Flips, encodes, and writes snapshots on a few background threads.  Snapshots may be encoded in
+// any order, but are written in the order they were queued.  At most `kQueueLimit` snapshots
+// wait at once; past that, write() blocks until one is done, so memory use stays bounded.
+//
+// Snapshots without a path go to `stream` as video frames instead of to PNG files.
+//
+// Errors on the background threads are kept, and rethrown by the next call to write() or
+// finish() on the main thread.
+class SnapshotWriter {
+  public:
+    explicit SnapshotWriter(FrameStream* stream) : _stream(stream) {
+        const int threads = max(1, std::min<int>(4, std::thread::hardware_concurrency()));
+        for (int i = 0; i < threads; ++i) {
+            _threads.emplace_back([this] { work(); });
+        }
+    }
+    SnapshotWriter(const SnapshotWriter&) = delete;
+    SnapshotWriter& operator=(const SnapshotWriter&) = delete;
+
+    ~SnapshotWriter() {
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _done.wait(lock, [this] { return _written == _queued; });
+        }
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _exit = true;
+        }
+        _wake.notify_all();
+        for (auto& t : _threads) {
+            t.join();
+        }
+    }
+
+    // Queues `bgra`, bottom row first as glReadPixels() returns it, to be written to `path`, or
+    // to the stream if `path` is empty.
+    void write(vector<uint8_t> bgra, Size size, pn::string path) {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _done.wait(lock, [this] { return (_queued - _written) < kQueueLimit; });
+        rethrow();
+        _jobs.push_back(Job{_queued++, std::move(bgra), size, std::move(path)});
+        _wake.notify_one();
+    }
+
+    // Returns once every queued snapshot has been written.
+    void finish() {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _done.wait(lock, [this] { return _written == _queued; });
+        rethrow();
+    }
+
+  private:
+    enum { kQueueLimit = 8 };
+
+    struct Job {
+        int64_t         sequence;
+        vector<uint8_t> bgra;
+        Size            size;
+        pn::string      path;
+    };
+
+    void work() {
+        std::unique_lock<std::mutex> lock(_mutex);
+        while (true) {
+            _wake.wait(lock, [this] { return _exit || !_jobs.empty(); });
+            if (_jobs.empty()) {
+                return;
+            }
+            Job job = std::move(_jobs.front());
+            _jobs.pop_front();
+            lock.unlock();
+
+            std::exception_ptr error;
+            pn::data           encoded;
+            try {
+                ArrayPixMap pix = flip(job.bgra, job.size);
+                if (job.path.empty()) {
+                    encoded = _stream->frame(pix);
+                } else {
+                    pix.encode(encoded.open("w"));
+                }
+            } catch (...) {
+                error = std::current_exception();
+            }
+
+            lock.lock();
+            _done.wait(lock, [this, &job] { return _written == job.sequence; });
+            lock.unlock();
+
+            if (!error) {
+                try {
+                    if (job.path.empty()) {
+                        _stream->write(encoded);
+                    } else {
+                        sfz::makedirs(path::dirname(job.path), 0755);
+                        pn::file file = pn::open(job.path, "w");
+                        file.write(encoded);
+                    }
+                } catch (...) {
+                    error = std::current_exception();
+                }
+            }
+
+            lock.lock();
+            if (error && !_error) {
+                _error = error;
+            }
+            ++_written;
+            _done.notify_all();
+        }
+    }
+
+    // Called with `_mutex` held.  Throws the first error from a background thread, once.
+    void rethrow() {
+        if (_error) {
+            std::exception_ptr error = _error;
+            _error                   = nullptr;
+            std::rethrow_exception(error);
+        }
+    }
+
+    static ArrayPixMap flip(const vector<uint8_t>& bgra, Size size) {
+        ArrayPixMap         pix(size);
+        const PixelKernels& k = pixel_kernels();
+        const uint8_t*      p = bgra.data();
+        for (int32_t y : range(size.height)) {
+            k.from_bgra(pix.mutable_row(size.height - y - 1), p, size.width);
+            p += 4 * size.width;
+        }
+        return pix;
+    }
+
+    FrameStream* const      _stream;
+    vector<std::thread>     _threads;
+    std::mutex              _mutex;
+    std::condition_variable _wake;
+    std::condition_variable _done;
+    std::deque<Job>         _jobs;
+    int64_t                 _queued  = 0;
+    int64_t                 _written = 0;
+    bool                    _exit    = false;
+    std::exception_ptr      _error;
+};
+
+// Reads snapshots back through two pixel buffer objects, so that glReadPixels() returns without
+// waiting for the frame to finish.  Each buffer's pixels are collected the next time it's
+// needed, by which point the GPU has long finished with it, or by flush().
 class SnapshotBuffer {
   public:
-    SnapshotBuffer() {}
+    SnapshotBuffer() { glGenBuffers(2, _pbo); }
+    SnapshotBuffer(const SnapshotBuffer&) = delete;
+    SnapshotBuffer& operator=(const SnapshotBuffer&) = delete;
+
+    ~SnapshotBuffer() { glDeleteBuffers(2, _pbo); }
+
+    void read(Rect bounds, pn::string path, SnapshotWriter& writer) {
+        Pending& pending = _pending[_next];
+        collect(_next, writer);
 
-    void copy(Rect bounds, ArrayPixMap& pix) {
-        _data.resize(bounds.area() * 4);
         Size size = bounds.size();
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, _pbo[_next]);
+        glBufferData(GL_PIXEL_PACK_BUFFER, bounds.area() * 4, nullptr, GL_STREAM_READ);
         glReadPixels(
                 bounds.left, bounds.top, size.width, size.height, GL_BGRA, GL_UNSIGNED_BYTE,
-                _data.data());
-        uint8_t* p = _data.data();
-        for (int32_t y : range(size.height)) {
-            for (int32_t x : range(size.width)) {
-                uint8_t blue  = *(p++);
-                uint8_t green = *(p++);
-                uint8_t red   = *(p++);
-                ++p;
-                pix.set(x, size.height - y - 1, rgb(red, green, blue));
-            }
-        }
+                nullptr);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        pending.size = size;
+        pending.path = std::move(path);
+        pending.busy = true;
+        _next ^= 1;
+    }
+
+    // Hands any reads still in flight to `writer`, oldest first.
+    void flush(SnapshotWriter& writer) {
+        collect(_next, writer);
+        collect(_next ^ 1, writer);
     }
 
   private:
-    vector<uint8_t> _data;
+    struct Pending {
+        Size       size;
+        pn::string path;
+        bool       busy = false;
+    };
+
+    void collect(int index, SnapshotWriter& writer) {
+        Pending& pending = _pending[index];
+        if (!pending.busy) {
+            return;
+        }
+        vector<uint8_t> bgra(pending.size.width * pending.size.height * 4);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, _pbo[index]);
+        const void* data = glMapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY);
+        if (data) {
+            memcpy(bgra.data(), data, bgra.size());
+        }
+        glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        pending.busy = false;
+        writer.write(std::move(bgra), pending.size, std::move(pending.path));
+    }
+
+    GLuint  _pbo[2];
+    Pending _pending[2];
+    int     _next = 0;
 };
 
 void gl_check() {
@@ -123,6 +314,7 @@ class OffscreenVideoDriver::MainLoop : public EventScheduler::MainLoop {
             Card* initial)
             : _driver(driver),
               _offscreen(driver._screen_size),
+              _writer(driver._stream),
               _setup(*this),
               _loop(driver, initial) {
         if (output_dir.has_value()) {
@@ -130,37 +322,62 @@ class OffscreenVideoDriver::MainLoop : public EventScheduler::MainLoop {
         }
     }
 
-    bool takes_snapshots() { return _output_dir.has_value(); }
+    // If finish() wasn't reached, snapshots still being read are handed off while the GL context
+    // is still around, and ~SnapshotWriter() waits for them.  Errors can't be reported from here.
+    ~MainLoop() {
+        try {
+            _buffer.flush(_writer);
+        } catch (...) {
+        }
+    }
+
+    // Writes out every snapshot taken so far, and throws the first error in doing so.
+    void finish() {
+        _buffer.flush(_writer);
+        _writer.finish();
+    }
+
+    bool takes_snapshots() { return _output_dir.has_value() || _driver._stream; }
 
     void snapshot(wall_ticks ticks) {
-        snapshot_to(
-                _driver._capture_rect,
-                pn::format("screens/{0}.png", dec(ticks.time_since_epoch().count(), 6)));
+        if (_driver._stream) {
+            read(_driver._capture_rect, pn::string());
+        } else {
+            snapshot_to(
+                    _driver._capture_rect,
+                    pn::format("screens/{0}.png", dec(ticks.time_since_epoch().count(), 6)));
+        }
     }
 
     void snapshot_to(Rect bounds, pn::string_view relpath) {
-        if (!takes_snapshots()) {
-            return;
+        if (_output_dir.has_value()) {
+            read(bounds, pn::format("{0}/{1}", *_output_dir, relpath));
         }
-        bounds.offset(0, _driver._screen_size.height - bounds.height() - bounds.top);
-        ArrayPixMap pix(bounds.size());
-        _buffer.copy(bounds, pix);
-        pn::string path = pn::format("{0}/{1}", *_output_dir, relpath);
-        sfz::makedirs(path::dirname(path), 0755);
-        pn::file file = pn::open(path, "w");
-        pix.encode(file);
     }
 
-    void  draw() { _loop.draw(); }
+    void draw() {
+        const auto start = std::chrono::steady_clock::now();
+        _loop.draw();
+        _driver._draw_time +=
+                std::chrono::duration_cast<usecs>(std::chrono::steady_clock::now() - start);
+        ++_driver._frames;
+    }
     bool  done() const { return _loop.done(); }
     Card* top() const { return _loop.top(); }
 
   private:
-    const OffscreenVideoDriver& _driver;
+    // Starts reading back `bounds` to write to `path`, or to the stream if `path` is empty.
+    void read(Rect bounds, pn::string path) {
+        bounds.offset(0, _driver._screen_size.height - bounds.height() - bounds.top);
+        _buffer.read(bounds, std::move(path), _writer);
+    }
+
+    OffscreenVideoDriver&       _driver;
     Offscreen                   _offscreen;
     Framebuffer                 _fb;
     Renderbuffer                _rb;
     SnapshotBuffer              _buffer;
+    SnapshotWriter              _writer;
     struct Setup {
         Setup(OffscreenVideoDriver::MainLoop& loop) {
             glBindFramebuffer(GL_FRAMEBUFFER, loop._fb.id);
@@ -185,10 +402,23 @@ OffscreenVideoDriver::OffscreenVideoDriver(
     }
 }
 
+pn::string OffscreenVideoDriver::frame_stats() const {
+    pn::string result = pn::format("frames: {0}\n", _frames);
+    if (_frames > 0) {
+        result += pn::format(
+                "draw calls: {0} ({1} per frame)\n", draw_calls(), draw_calls() / _frames);
+        result += pn::format(
+                "draw time: {0} ms ({1} us per frame)\n", _draw_time.count() / 1000,
+                _draw_time.count() / _frames);
+    }
+    return result;
+}
+
 void OffscreenVideoDriver::loop(Card* initial, EventScheduler& scheduler) {
     _scheduler = &scheduler;
     MainLoop loop(*this, _output_dir, initial);
     _scheduler->loop(loop);
+    loop.finish();
     _scheduler = nullptr;
 }
 
@@ -217,6 +447,7 @@ void OffscreenVideoDriver::capture(vector<pair<unique_ptr<Card>, pn::string>>& p
         loop.snapshot_to(_capture_rect, p.second);
         loop.top()->stack()->pop(loop.top());
     }
+    loop.finish();
 }
 
 }  // namespace antares
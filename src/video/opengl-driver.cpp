@@ -18,9 +18,13 @@
 
 #include "video/opengl-driver.hpp"
 
+#include <stddef.h>
 #include <stdint.h>
+#include <string.h>
 #include <algorithm>
+#include <memory>
 #include <pn/file>
+#include <vector>
 
 #include "drawing/color.hpp"
 #include "drawing/pix-map.hpp"
@@ -145,6 +149,8 @@ static T _gl_check(T t, const char* fn, const char* file, int line) {
     _GL(glShaderSource, shader, count, string, length)
 #define glTexImage2D(target, level, internalformat, width, height, border, format, type, pixels) \
     _GL(glTexImage2D, target, level, internalformat, width, height, border, format, type, pixels)
+#define glTexSubImage2D(target, level, xoffset, yoffset, width, height, format, type, pixels) \
+    _GL(glTexSubImage2D, target, level, xoffset, yoffset, width, height, format, type, pixels)
 #define glUniform1f(location, v0) _GL(glUniform1f, location, v0)
 #define glUniform1i(location, v0) _GL(glUniform1i, location, v0)
 #define glUniform2f(location, v0, v1) _GL(glUniform2f, location, v0, v1)
@@ -159,6 +165,9 @@ static T _gl_check(T t, const char* fn, const char* file, int line) {
 #define glGenBuffers(n, buffers) _GL(glGenBuffers, n, buffers)
 #define glBindBuffer(target, buffer) _GL(glBindBuffer, target, buffer)
 #define glBufferData(target, size, data, usage) _GL(glBufferData, target, size, data, usage)
+#define glMapBufferRange(target, offset, length, access) \
+    _GLV(glMapBufferRange, target, offset, length, access)
+#define glUnmapBuffer(target) _GLV(glUnmapBuffer, target)
 #define glVertexAttribPointer(index, size, type, normalized, stride, pointer) \
     _GL(glVertexAttribPointer, index, size, type, normalized, stride, pointer)
 #define glEnableVertexAttribArray(index) _GL(glEnableVertexAttribArray, index)
@@ -185,266 +194,480 @@ void gl_log(GLint object) {
     pn::format(stderr, "object {0} log: {1}\n", object, (const char*)log.get());
 }
 
-class OpenGlTextureImpl : public Texture::Impl {
+}  // namespace
+
+class OpenGlVideoDriver::Batch {
   public:
-    OpenGlTextureImpl(
-            pn::string_view name, const PixMap& image, const OpenGlVideoDriver::Uniforms& uniforms,
-            GLuint vbuf[3])
-            : _name(name.copy()), _size(image.size()), _uniforms(uniforms), _vbuf(vbuf) {
-        glBindTexture(GL_TEXTURE_RECTANGLE, _texture.id);
+    // Everything that has to be the same for two vertices to be drawn in one call.  Parameters
+    // that the current color mode doesn't read are left at zero, so that they don't split
+    // batches.
+    struct State {
+        GLenum primitive;
+        int    color_mode;
+        GLuint texture;
+        float  static_fraction;
+        vec2   unit;
+        vec4   outline_color;
+        vec4   sprite_bounds;
+
+        bool operator==(const State& other) const {
+            return (primitive == other.primitive) && (color_mode == other.color_mode) &&
+                   (texture == other.texture) && (static_fraction == other.static_fraction) &&
+                   (unit.x == other.unit.x) && (unit.y == other.unit.y) &&
+                   same(outline_color, other.outline_color) &&
+                   same(sprite_bounds, other.sprite_bounds);
+        }
+        bool operator!=(const State& other) const { return !(*this == other); }
+
+        static bool same(const vec4& x, const vec4& y) {
+            return (x.x == y.x) && (x.y == y.y) && (x.z == y.z) && (x.w == y.w);
+        }
+    };
+
+    struct Vertex {
+        GLfloat x, y;
+        GLubyte color[4];
+        GLshort u, v;
+    };
+
+    Batch(const std::shared_ptr<Uniforms>& uniforms) : _uniforms(uniforms) {}
+    Batch(const Batch&) = delete;
+    Batch& operator=(const Batch&) = delete;
+
+    // Needs a current context.  Called with each new program, before its first frame.
+    void setup() {
+        _vertices.clear();
+        _offset  = 0;
+        _applied = {GL_POINTS,    -1, 0, -1.0f, {-1.0f, -1.0f}, {-1.0f, -1.0f, -1.0f, -1.0f},
+                    {-1.0f, -1.0f, -1.0f, -1.0f}};
+
+        glGenBuffers(1, &_buffer);
+        glBindBuffer(GL_ARRAY_BUFFER, _buffer);
+        glBufferData(GL_ARRAY_BUFFER, kBufferSize * sizeof(Vertex), nullptr, GL_STREAM_DRAW);
+        glVertexAttribPointer(
+                0, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex),
+                reinterpret_cast<void*>(offsetof(Vertex, x)));
+        glVertexAttribPointer(
+                1, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(Vertex),
+                reinterpret_cast<void*>(offsetof(Vertex, color)));
+        glVertexAttribPointer(
+                2, 2, GL_SHORT, GL_FALSE, sizeof(Vertex),
+                reinterpret_cast<void*>(offsetof(Vertex, u)));
+        glEnableVertexAttribArray(0);
+        glEnableVertexAttribArray(1);
+        glEnableVertexAttribArray(2);
+        _vertices.reserve(kBufferSize);
+    }
+
+    // Returns space for `count` vertices, drawn with `state`.  Flushes first if the state
+    // differs from that of the vertices already waiting, or there isn't room for them.
+    Vertex* add(const State& state, int count) {
+        if (!_vertices.empty() && (state != _state)) {
+            flush();
+        }
+        _state = state;
+        return extend(count);
+    }
+
+    // Like add(), with the state of the last call to add().  For long runs of points or lines,
+    // where comparing the state for every vertex would cost more than writing it.
+    Vertex* extend(int count) {
+        if ((_vertices.size() + count) > kBufferSize) {
+            flush();
+        }
+        size_t begin = _vertices.size();
+        _vertices.resize(begin + count);
+        return &_vertices[begin];
+    }
+
+    // Draws any waiting vertices.
+    void flush() {
+        if (_vertices.empty()) {
+            return;
+        }
+        apply(_state);
+
+        // Once the buffer is full, orphan it rather than wait for the GPU to finish reading it.
+        // Until then, each flush writes past the last, so no range is written while it may still
+        // be read, and mapping it doesn't need to synchronize.
+        const size_t count = _vertices.size();
+        glBindBuffer(GL_ARRAY_BUFFER, _buffer);
+        if ((_offset + count) > kBufferSize) {
+            glBufferData(GL_ARRAY_BUFFER, kBufferSize * sizeof(Vertex), nullptr, GL_STREAM_DRAW);
+            _offset = 0;
+        }
+        void* data = glMapBufferRange(
+                GL_ARRAY_BUFFER, _offset * sizeof(Vertex), count * sizeof(Vertex),
+                GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+        memcpy(data, _vertices.data(), count * sizeof(Vertex));
+        glUnmapBuffer(GL_ARRAY_BUFFER);
+
+        glDrawArrays(_state.primitive, _offset, count);
+        _offset += count;
+        _vertices.clear();
+        ++_draws;
+    }
+
+    // The number of calls to glDrawArrays() so far.
+    int64_t draws() const { return _draws; }
+
+    // Called before `texture` is deleted, in case waiting vertices still sample it.
+    void forget(GLuint texture) {
+        if (!_vertices.empty() && (_state.texture == texture)) {
+            flush();
+        }
+    }
+
+  private:
+    enum { kBufferSize = 1 << 16 };
+
+    void apply(const State& state) {
+        if (state.color_mode != _applied.color_mode) {
+            _uniforms->color_mode.set(state.color_mode);
+        }
+        if (state.static_fraction != _applied.static_fraction) {
+            _uniforms->static_fraction.set(state.static_fraction);
+        }
+        if ((state.unit.x != _applied.unit.x) || (state.unit.y != _applied.unit.y)) {
+            _uniforms->unit.set(state.unit);
+        }
+        if (!State::same(state.outline_color, _applied.outline_color)) {
+            _uniforms->outline_color.set(state.outline_color);
+        }
+        if (!State::same(state.sprite_bounds, _applied.sprite_bounds)) {
+            _uniforms->sprite_bounds.set(state.sprite_bounds);
+        }
+        if (state.texture) {
+            // Always bind: creating a texture binds it, behind the batch's back.
+            glActiveTexture(GL_TEXTURE0);
+            glBindTexture(GL_TEXTURE_RECTANGLE, state.texture);
+        }
+        _applied = state;
+    }
+
+    const std::shared_ptr<Uniforms> _uniforms;
+    GLuint                          _buffer = 0;
+    size_t                          _offset = 0;
+    int64_t                         _draws  = 0;
+    std::vector<Vertex>             _vertices;
+    State                           _state;
+    State                           _applied;  // as last loaded into the program
+};
+
+namespace {
+
+typedef OpenGlVideoDriver::Batch Batch;
+
+Batch::State fill_state(GLenum primitive, int color_mode) {
+    Batch::State state = {};
+    state.primitive    = primitive;
+    state.color_mode   = color_mode;
+    return state;
+}
+
+void set_color(Batch::Vertex* vertex, const RgbColor& color) {
+    vertex->color[0] = color.red;
+    vertex->color[1] = color.green;
+    vertex->color[2] = color.blue;
+    vertex->color[3] = color.alpha;
+}
+
+// Points are drawn through the center of the pixel they cover.
+void set_point(Batch::Vertex* vertex, const Point& at, const RgbColor& color) {
+    *vertex = Batch::Vertex{GLfloat(at.h + 0.5), GLfloat(at.v + 0.5), {}, 0, 0};
+    set_color(vertex, color);
+}
+
+// Adds `dest` to the batch as two triangles, with `source` as texture coordinates.
+void add_quad(
+        Batch* batch, const Batch::State& state, const Rect& dest, const Rect& source,
+        const RgbColor& color) {
+    Batch::Vertex* v = batch->add(state, 6);
+    const struct {
+        int32_t x, y, u, v;
+    } corners[6] = {
+            {dest.left, dest.top, source.left, source.top},
+            {dest.left, dest.bottom, source.left, source.bottom},
+            {dest.right, dest.bottom, source.right, source.bottom},
+            {dest.left, dest.top, source.left, source.top},
+            {dest.right, dest.bottom, source.right, source.bottom},
+            {dest.right, dest.top, source.right, source.top},
+    };
+    for (const auto& c : corners) {
+        v->x = c.x;
+        v->y = c.y;
+        v->u = c.u;
+        v->v = c.v;
+        set_color(v++, color);
+    }
+}
+
+}  // namespace
+
+// A texture object holding one or more images, each with a clear border one texel wide.  The
+// border keeps samples at the edge of an image from reaching its neighbors.
+//
+// texture() gives each image a sheet of its own.  atlas_texture() packs images into shared pages,
+// on shelves: rows as tall as the first image placed in them, filled left to right.  Space is
+// only reclaimed once every image on a page is gone, at which point the page starts over.
+class OpenGlVideoDriver::Sheet {
+  public:
+    Sheet(const std::shared_ptr<Batch>& batch, Size size) : _batch(batch), _size(size) {
+        glGenTextures(1, &_id);
+        glBindTexture(GL_TEXTURE_RECTANGLE, _id);
         glTexParameteri(GL_TEXTURE_RECTANGLE, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
         glTexParameteri(GL_TEXTURE_RECTANGLE, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
         glTexParameteri(GL_TEXTURE_RECTANGLE, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
         glTexParameteri(GL_TEXTURE_RECTANGLE, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTexImage2D(
+                GL_TEXTURE_RECTANGLE, 0, GL_RGBA, size.width, size.height, 0, GL_BGRA,
+                pixel_type(), nullptr);
+    }
+    Sheet(const Sheet&) = delete;
+    Sheet& operator=(const Sheet&) = delete;
+
+    ~Sheet() {
+        _batch->forget(_id);
+        glDeleteTextures(1, &_id);
+    }
+
+    GLuint      id() const { return _id; }
+    const Size& size() const { return _size; }
+    int         images() const { return _images; }
+    int64_t     used() const { return _used; }
+    int32_t     extent() const { return _extent; }
+
+    // Uploads `image`, with its border, and sets `cell` to the space it takes up.  Returns false
+    // if there's no room for it.
+    bool add(const PixMap& image, Rect* cell) {
+        const Size size(image.size().width + 2, image.size().height + 2);
+        if (!place(size, cell)) {
+            return false;
+        }
+        ++_images;
+        _used += size.width * size.height;
+
+        ArrayPixMap copy(size);
+        copy.fill(RgbColor::clear());
+        copy.view(Rect(1, 1, size.width - 1, size.height - 1)).copy(image);
+        _batch->forget(_id);  // waiting vertices may sample a cell that's being reused
+        glBindTexture(GL_TEXTURE_RECTANGLE, _id);
+        glTexSubImage2D(
+                GL_TEXTURE_RECTANGLE, 0, cell->left, cell->top, size.width, size.height, GL_BGRA,
+                pixel_type(), copy.bytes());
+        return true;
+    }
+
+    void remove(const Rect& cell) {
+        _used -= cell.area();
+        if (--_images == 0) {
+            _shelves.clear();
+            _extent = 0;
+        }
+    }
+
+  private:
+    struct Shelf {
+        int32_t top, height, right;
+    };
+
+    static GLenum pixel_type() {
 #if defined(__LITTLE_ENDIAN__)
-        GLenum type = GL_UNSIGNED_INT_8_8_8_8;
+        return GL_UNSIGNED_INT_8_8_8_8;
 #elif defined(__BIG_ENDIAN__)
-        GLenum type = GL_UNSIGNED_INT_8_8_8_8_REV;
+        return GL_UNSIGNED_INT_8_8_8_8_REV;
 #else
 #error "Couldn't determine endianness of platform"
 #endif
+    }
 
-        // Add a 1-pixel clear border.  Color mode 5 (outline) won't work unless we do this.
-        Size size = image.size();
-        size.width += 2;
-        size.height += 2;
-        ArrayPixMap copy(size);
-        copy.fill(RgbColor::clear());
-        copy.view(Rect(1, 1, size.width - 1, size.height - 1)).copy(image);
-        glTexImage2D(
-                GL_TEXTURE_RECTANGLE, 0, GL_RGBA, size.width, size.height, 0, GL_BGRA, type,
-                copy.bytes());
+    // Picks the shortest shelf that the image fits on, opening a new one if none do.
+    bool place(Size size, Rect* cell) {
+        Shelf* best = nullptr;
+        for (Shelf& shelf : _shelves) {
+            if ((shelf.height >= size.height) && ((shelf.right + size.width) <= _size.width) &&
+                (!best || (shelf.height < best->height))) {
+                best = &shelf;
+            }
+        }
+        if (!best) {
+            if (((_extent + size.height) > _size.height) || (size.width > _size.width)) {
+                return false;
+            }
+            _shelves.push_back(Shelf{_extent, size.height, 0});
+            _extent += size.height;
+            best = &_shelves.back();
+        }
+        *cell = Rect(Point(best->right, best->top), size);
+        best->right += size.width;
+        return true;
     }
 
+    const std::shared_ptr<Batch> _batch;
+    GLuint                       _id;
+    const Size                   _size;
+    std::vector<Shelf>           _shelves;
+    int32_t                      _extent = 0;
+    int                          _images = 0;
+    int64_t                      _used   = 0;
+};
+
+namespace {
+
+typedef OpenGlVideoDriver::Sheet Sheet;
+
+// An image in a sheet.  `_cell` is where it sits, including its border.
+class OpenGlTextureImpl : public Texture::Impl {
+  public:
+    OpenGlTextureImpl(
+            pn::string_view name, const std::shared_ptr<Batch>& batch,
+            const std::shared_ptr<Sheet>& sheet, const Rect& cell)
+            : _name(name.copy()),
+              _size(cell.width() - 2, cell.height() - 2),
+              _batch(batch),
+              _sheet(sheet),
+              _cell(cell) {}
+
+    ~OpenGlTextureImpl() { _sheet->remove(_cell); }
+
     virtual pn::string_view name() const { return _name; }
 
     virtual void draw(const Rect& draw_rect) const {
-        _uniforms.color_mode.set(DRAW_SPRITE_MODE);
-        draw_internal(draw_rect, RgbColor::white());
+        draw_internal(state(DRAW_SPRITE_MODE), draw_rect, RgbColor::white());
     }
 
     virtual void draw_cropped(const Rect& dest, const Rect& source, const RgbColor& tint) const {
-        begin_quads();
         draw_quad(dest, source, tint);
-        end_quads();
     }
 
     virtual void draw_shaded(const Rect& draw_rect, const RgbColor& tint) const {
-        _uniforms.color_mode.set(TINT_SPRITE_MODE);
-        draw_internal(draw_rect, tint);
+        draw_internal(state(TINT_SPRITE_MODE), draw_rect, tint);
     }
 
     virtual void draw_static(const Rect& draw_rect, const RgbColor& color, uint8_t frac) const {
-        _uniforms.color_mode.set(STATIC_SPRITE_MODE);
-        _uniforms.static_fraction.set(frac / 255.0f);
-        draw_internal(draw_rect, color);
+        Batch::State s    = state(STATIC_SPRITE_MODE);
+        s.static_fraction = frac / 255.0f;
+        draw_internal(s, draw_rect, color);
     }
 
+    // Outlines sample neighboring texels, which may lie outside the image when it's scaled
+    // down, so they're clamped to the centers of the image's own texels, not its border.  Like a
+    // clamp to the edge of the image, this repeats its edge texels.
     virtual void draw_outlined(
             const Rect& draw_rect, const RgbColor& outline_color,
             const RgbColor& fill_color) const {
-        _uniforms.color_mode.set(OUTLINE_SPRITE_MODE);
-        _uniforms.unit.set({float(_size.width) / draw_rect.width(),
-                            float(_size.height) / draw_rect.height()});
-        _uniforms.outline_color.set({outline_color.red / 255.0f, outline_color.green / 255.0f,
-                                     outline_color.blue / 255.0f, outline_color.alpha / 255.0f});
-        draw_internal(draw_rect, fill_color);
+        Batch::State s  = state(OUTLINE_SPRITE_MODE);
+        s.unit          = {float(_size.width) / draw_rect.width(),
+                           float(_size.height) / draw_rect.height()};
+        s.outline_color = {outline_color.red / 255.0f, outline_color.green / 255.0f,
+                           outline_color.blue / 255.0f, outline_color.alpha / 255.0f};
+        s.sprite_bounds = {_cell.left + 1.5f, _cell.top + 1.5f, _cell.right - 1.5f,
+                           _cell.bottom - 1.5f};
+        draw_internal(s, draw_rect, fill_color);
     }
 
     virtual const Size& size() const { return _size; }
 
   private:
-    virtual void draw_internal(const Rect& draw_rect, const RgbColor& tint) const {
-        glEnableVertexAttribArray(0);
-        glEnableVertexAttribArray(1);
-        glEnableVertexAttribArray(2);
+    Batch::State state(int color_mode) const {
+        Batch::State state = {};
+        state.primitive    = GL_TRIANGLES;
+        state.color_mode   = color_mode;
+        state.texture      = _sheet->id();
+        return state;
+    }
 
-        glBindBuffer(GL_ARRAY_BUFFER, _vbuf[0]);
-        GLshort vertices[] = {
-                GLshort(draw_rect.left),   GLshort(draw_rect.top),   GLshort(draw_rect.left),
-                GLshort(draw_rect.bottom), GLshort(draw_rect.right), GLshort(draw_rect.bottom),
-                GLshort(draw_rect.right),  GLshort(draw_rect.top),
-        };
-        glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STREAM_DRAW);
-        glVertexAttribPointer(0, 2, GL_SHORT, GL_FALSE, 0, nullptr);
-
-        glBindBuffer(GL_ARRAY_BUFFER, _vbuf[1]);
-        GLubyte colors[] = {
-                tint.red,  tint.green, tint.blue, tint.alpha, tint.red,  tint.green,
-                tint.blue, tint.alpha, tint.red,  tint.green, tint.blue, tint.alpha,
-                tint.red,  tint.green, tint.blue, tint.alpha,
-        };
-        glBufferData(GL_ARRAY_BUFFER, sizeof(colors), colors, GL_STREAM_DRAW);
-        glVertexAttribPointer(1, 4, GL_UNSIGNED_BYTE, GL_TRUE, 0, nullptr);
-
-        glBindBuffer(GL_ARRAY_BUFFER, _vbuf[2]);
-        const int32_t w            = _size.width;
-        const int32_t h            = _size.height;
-        GLshort       tex_coords[] = {
-                GLshort(1),     GLshort(1),     GLshort(1),     GLshort(h + 1),
-                GLshort(w + 1), GLshort(h + 1), GLshort(w + 1), GLshort(1),
-        };
-        glBufferData(GL_ARRAY_BUFFER, sizeof(tex_coords), tex_coords, GL_STREAM_DRAW);
-        glVertexAttribPointer(2, 2, GL_SHORT, GL_FALSE, 0, nullptr);
-
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_RECTANGLE, _texture.id);
-        glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
-
-        glDisableVertexAttribArray(2);
-        glDisableVertexAttribArray(1);
-        glDisableVertexAttribArray(0);
-    }
-
-    virtual void begin_quads() const {
-        _uniforms.color_mode.set(TINT_SPRITE_MODE);
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_RECTANGLE, _texture.id);
-    }
-
-    virtual void end_quads() const {}
+    void draw_internal(const Batch::State& s, const Rect& draw_rect, const RgbColor& tint) const {
+        draw_source(s, draw_rect, _size.as_rect(), tint);
+    }
 
     virtual void draw_quad(const Rect& dest, const Rect& source, const RgbColor& tint) const {
-        glEnableVertexAttribArray(0);
-        glEnableVertexAttribArray(1);
-        glEnableVertexAttribArray(2);
+        draw_source(state(TINT_SPRITE_MODE), dest, source, tint);
+    }
 
-        glBindBuffer(GL_ARRAY_BUFFER, _vbuf[0]);
-        GLshort vertices[] = {
-                GLshort(dest.left),   GLshort(dest.top),   GLshort(dest.left),
-                GLshort(dest.bottom), GLshort(dest.right), GLshort(dest.bottom),
-                GLshort(dest.right),  GLshort(dest.top),
-        };
-        glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STREAM_DRAW);
-        glVertexAttribPointer(0, 2, GL_SHORT, GL_FALSE, 0, nullptr);
-
-        glBindBuffer(GL_ARRAY_BUFFER, _vbuf[1]);
-        GLubyte colors[] = {
-                tint.red,  tint.green, tint.blue, tint.alpha, tint.red,  tint.green,
-                tint.blue, tint.alpha, tint.red,  tint.green, tint.blue, tint.alpha,
-                tint.red,  tint.green, tint.blue, tint.alpha,
-        };
-        glBufferData(GL_ARRAY_BUFFER, sizeof(colors), colors, GL_STREAM_DRAW);
-        glVertexAttribPointer(1, 4, GL_UNSIGNED_BYTE, GL_TRUE, 0, nullptr);
-
-        Rect texture_rect = source;
-        texture_rect.offset(1, 1);
-        glBindBuffer(GL_ARRAY_BUFFER, _vbuf[2]);
-        GLshort tex_coords[] = {
-                GLshort(texture_rect.left),  GLshort(texture_rect.top),
-                GLshort(texture_rect.left),  GLshort(texture_rect.bottom),
-                GLshort(texture_rect.right), GLshort(texture_rect.bottom),
-                GLshort(texture_rect.right), GLshort(texture_rect.top),
-        };
-        glBufferData(GL_ARRAY_BUFFER, sizeof(tex_coords), tex_coords, GL_STREAM_DRAW);
-        glVertexAttribPointer(2, 2, GL_SHORT, GL_FALSE, 0, nullptr);
-
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_RECTANGLE, _texture.id);
-        glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
-
-        glDisableVertexAttribArray(2);
-        glDisableVertexAttribArray(1);
-        glDisableVertexAttribArray(0);
-    }
-
-    struct Texture {
-        Texture() { glGenTextures(1, &id); }
-        Texture(const Texture&) = delete;
-        Texture& operator=(const Texture&) = delete;
-        ~Texture() { glDeleteTextures(1, &id); }
-
-        GLuint id;
-    };
+    void draw_source(
+            const Batch::State& s, const Rect& dest, Rect source, const RgbColor& tint) const {
+        source.offset(_cell.left + 1, _cell.top + 1);
+        add_quad(_batch.get(), s, dest, source, tint);
+    }
 
-    const pn::string                   _name;
-    Texture                            _texture;
-    Size                               _size;
-    const OpenGlVideoDriver::Uniforms& _uniforms;
-    GLuint*                            _vbuf;
+    const pn::string             _name;
+    const Size                   _size;
+    const std::shared_ptr<Batch> _batch;
+    const std::shared_ptr<Sheet> _sheet;
+    const Rect                   _cell;
 };
 
 }  // namespace
 
-OpenGlVideoDriver::OpenGlVideoDriver() : _static_seed{0} {}
+OpenGlVideoDriver::OpenGlVideoDriver()
+        : _static_seed{0}, _uniforms(new Uniforms), _batch(new Batch(_uniforms)) {}
+
+OpenGlVideoDriver::~OpenGlVideoDriver() {}
 
 int OpenGlVideoDriver::scale() const { return viewport_size().width / screen_size().width; }
 
 Texture OpenGlVideoDriver::texture(pn::string_view name, const PixMap& content) {
-    return unique_ptr<Texture::Impl>(new OpenGlTextureImpl(name, content, _uniforms, _vbuf));
+    const Size size(content.size().width + 2, content.size().height + 2);
+    std::shared_ptr<Sheet> sheet(new Sheet(_batch, size));
+    Rect                   cell;
+    sheet->add(content, &cell);
+    return unique_ptr<Texture::Impl>(new OpenGlTextureImpl(name, _batch, sheet, cell));
 }
 
-void OpenGlVideoDriver::begin_rects() { _uniforms.color_mode.set(FILL_MODE); }
-
-void OpenGlVideoDriver::batch_rect(const Rect& rect, const RgbColor& color) {
-    glEnableVertexAttribArray(0);
-    glEnableVertexAttribArray(1);
-
-    glBindBuffer(GL_ARRAY_BUFFER, _vbuf[0]);
-    GLshort vertices[] = {
-            GLshort(rect.right), GLshort(rect.top),    GLshort(rect.left),  GLshort(rect.top),
-            GLshort(rect.left),  GLshort(rect.bottom), GLshort(rect.right), GLshort(rect.bottom),
-    };
-    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STREAM_DRAW);
-    glVertexAttribPointer(0, 2, GL_SHORT, GL_FALSE, 0, nullptr);
-
-    glBindBuffer(GL_ARRAY_BUFFER, _vbuf[1]);
-    GLubyte colors[] = {
-            color.red,  color.green, color.blue, color.alpha, color.red,  color.green,
-            color.blue, color.alpha, color.red,  color.green, color.blue, color.alpha,
-            color.red,  color.green, color.blue, color.alpha,
-    };
-    glBufferData(GL_ARRAY_BUFFER, sizeof(colors), colors, GL_STREAM_DRAW);
-    glVertexAttribPointer(1, 4, GL_UNSIGNED_BYTE, GL_TRUE, 0, nullptr);
-
-    glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
+Texture OpenGlVideoDriver::atlas_texture(pn::string_view name, const PixMap& content) {
+    if (((content.size().width + 2) > kMaxAtlasImageSize) ||
+        ((content.size().height + 2) > kMaxAtlasImageSize)) {
+        return texture(name, content);
+    }
+    Rect cell;
+    for (const auto& page : _atlas) {
+        if (page->add(content, &cell)) {
+            return unique_ptr<Texture::Impl>(new OpenGlTextureImpl(name, _batch, page, cell));
+        }
+    }
+    _atlas.emplace_back(new Sheet(_batch, Size(kAtlasPageSize, kAtlasPageSize)));
+    _atlas.back()->add(content, &cell);
+    return unique_ptr<Texture::Impl>(new OpenGlTextureImpl(name, _batch, _atlas.back(), cell));
+}
 
-    glDisableVertexAttribArray(1);
-    glDisableVertexAttribArray(0);
+int64_t OpenGlVideoDriver::draw_calls() const { return _batch->draws(); }
+
+pn::string OpenGlVideoDriver::atlas_stats() const {
+    pn::string stats = pn::format(
+            "atlas: {0} pages of {1}x{1}\n", int64_t(_atlas.size()), int(kAtlasPageSize));
+    for (int i = 0; i < _atlas.size(); ++i) {
+        const Sheet&  page = *_atlas[i];
+        const int64_t area = int64_t(kAtlasPageSize) * kAtlasPageSize;
+        stats += pn::format(
+                "  page {0}: {1} images, {2}% used, {3}% shelved\n", i, page.images(),
+                (page.used() * 100) / area, (int64_t(page.extent()) * 100) / kAtlasPageSize);
+    }
+    return stats;
 }
 
-void OpenGlVideoDriver::end_rects() {}
+void OpenGlVideoDriver::batch_rect(const Rect& rect, const RgbColor& color) {
+    add_quad(_batch.get(), fill_state(GL_TRIANGLES, FILL_MODE), rect, Rect(), color);
+}
 
 void OpenGlVideoDriver::dither_rect(const Rect& rect, const RgbColor& color) {
-    _uniforms.color_mode.set(DITHER_MODE);
-    batch_rect(rect, color);
+    add_quad(_batch.get(), fill_state(GL_TRIANGLES, DITHER_MODE), rect, Rect(), color);
 }
 
-void OpenGlVideoDriver::begin_points() { _uniforms.color_mode.set(FILL_MODE); }
-
-void OpenGlVideoDriver::end_points() {}
+// Points and Lines only draw points and lines, so their state is set once, when they begin, and
+// each vertex is added without comparing it.  draw_point() may come between anything, so it
+// can't skip the comparison.
+void OpenGlVideoDriver::begin_points() { _batch->add(fill_state(GL_POINTS, FILL_MODE), 0); }
 
 void OpenGlVideoDriver::batch_point(const Point& at, const RgbColor& color) {
-    glEnableVertexAttribArray(0);
-    glEnableVertexAttribArray(1);
-
-    glBindBuffer(GL_ARRAY_BUFFER, _vbuf[0]);
-    GLfloat vertices[] = {GLfloat(at.h + 0.5), GLfloat(at.v + 0.5)};
-    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STREAM_DRAW);
-    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 0, nullptr);
-
-    glBindBuffer(GL_ARRAY_BUFFER, _vbuf[1]);
-    GLubyte colors[] = {
-            color.red, color.green, color.blue, color.alpha,
-    };
-    glBufferData(GL_ARRAY_BUFFER, sizeof(colors), colors, GL_STREAM_DRAW);
-    glVertexAttribPointer(1, 4, GL_UNSIGNED_BYTE, GL_TRUE, 0, nullptr);
-
-    glDrawArrays(GL_POINTS, 0, 1);
-
-    glDisableVertexAttribArray(1);
-    glDisableVertexAttribArray(0);
+    set_point(_batch->extend(1), at, color);
 }
 
 void OpenGlVideoDriver::draw_point(const Point& at, const RgbColor& color) {
-    begin_points();
-    batch_point(at, color);
-    end_points();
+    set_point(_batch->add(fill_state(GL_POINTS, FILL_MODE), 1), at, color);
 }
 
-void OpenGlVideoDriver::begin_lines() { _uniforms.color_mode.set(FILL_MODE); }
-
-void OpenGlVideoDriver::end_lines() {}
+void OpenGlVideoDriver::begin_lines() { _batch->add(fill_state(GL_LINES, FILL_MODE), 0); }
 
 void OpenGlVideoDriver::batch_line(const Point& from, const Point& to, const RgbColor& color) {
     //
@@ -479,26 +702,11 @@ void OpenGlVideoDriver::batch_line(const Point& from, const Point& to, const Rgb
         y2 += 1.0f;
     }
 
-    glEnableVertexAttribArray(0);
-    glEnableVertexAttribArray(1);
-
-    glBindBuffer(GL_ARRAY_BUFFER, _vbuf[0]);
-    GLfloat vertices[] = {x1, y1, x2, y2};
-    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STREAM_DRAW);
-    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 0, nullptr);
-
-    glBindBuffer(GL_ARRAY_BUFFER, _vbuf[1]);
-    GLubyte colors[] = {
-            color.red, color.green, color.blue, color.alpha,
-            color.red, color.green, color.blue, color.alpha,
-    };
-    glBufferData(GL_ARRAY_BUFFER, sizeof(colors), colors, GL_STREAM_DRAW);
-    glVertexAttribPointer(1, 4, GL_UNSIGNED_BYTE, GL_TRUE, 0, nullptr);
-
-    glDrawArrays(GL_LINES, 0, 2);
-
-    glDisableVertexAttribArray(1);
-    glDisableVertexAttribArray(0);
+    Batch::Vertex* v = _batch->extend(2);
+    v[0]             = Batch::Vertex{x1, y1, {}, 0, 0};
+    v[1]             = Batch::Vertex{x2, y2, {}, 0, 0};
+    set_color(&v[0], color);
+    set_color(&v[1], color);
 }
 
 void OpenGlVideoDriver::draw_line(const Point& from, const Point& to, const RgbColor& color) {
@@ -590,17 +798,18 @@ OpenGlVideoDriver::MainLoop::Setup::Setup(OpenGlVideoDriver& driver) {
     glGenVertexArrays(1, &array);
     glBindVertexArray(array);
 
-    glGenBuffers(3, driver._vbuf);
-
-    driver._uniforms.screen.load(program);
-    driver._uniforms.scale.load(program);
-    driver._uniforms.color_mode.load(program);
-    driver._uniforms.sprite.load(program);
-    driver._uniforms.static_image.load(program);
-    driver._uniforms.static_fraction.load(program);
-    driver._uniforms.unit.load(program);
-    driver._uniforms.outline_color.load(program);
-    driver._uniforms.seed.load(program);
+    driver._batch->setup();
+
+    driver._uniforms->screen.load(program);
+    driver._uniforms->scale.load(program);
+    driver._uniforms->color_mode.load(program);
+    driver._uniforms->sprite.load(program);
+    driver._uniforms->static_image.load(program);
+    driver._uniforms->static_fraction.load(program);
+    driver._uniforms->unit.load(program);
+    driver._uniforms->outline_color.load(program);
+    driver._uniforms->sprite_bounds.load(program);
+    driver._uniforms->seed.load(program);
     glUseProgram(program);
 
     GLuint static_texture;
@@ -620,8 +829,9 @@ OpenGlVideoDriver::MainLoop::Setup::Setup(OpenGlVideoDriver& driver) {
     glTexImage2D(
             GL_TEXTURE_2D, 0, GL_RG, size, size, 0, GL_RG, GL_UNSIGNED_BYTE, static_data.get());
 
-    driver._uniforms.sprite.set(0);
-    driver._uniforms.static_image.set(1);
+    driver._uniforms->sprite.set(0);
+    driver._uniforms->static_image.set(1);
+    glActiveTexture(GL_TEXTURE0);
 }
 
 OpenGlVideoDriver::MainLoop::MainLoop(OpenGlVideoDriver& driver, Card* initial)
@@ -636,15 +846,16 @@ void OpenGlVideoDriver::MainLoop::draw() {
     glViewport(0, 0, _driver.viewport_size().width, _driver.viewport_size().height);
 
     auto screen = _driver.screen_size();
-    _driver._uniforms.screen.set({screen.width * 1.0f, screen.height * 1.0f});
-    _driver._uniforms.scale.set(_driver.scale());
+    _driver._uniforms->screen.set({screen.width * 1.0f, screen.height * 1.0f});
+    _driver._uniforms->scale.set(_driver.scale());
 
     int32_t seed = {_driver._static_seed.next(256)};
     seed <<= 8;
     seed += _driver._static_seed.next(256);
-    _driver._uniforms.seed.set(seed);
+    _driver._uniforms->seed.set(seed);
 
     _stack.top()->draw();
+    _driver._batch->flush();
 
     glFinish();
 }
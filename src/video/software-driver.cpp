@@ -0,0 +1,407 @@
+// Copyright (C) 1997, 1999-2001, 2008 Nathan Lamont
+// Copyright (C) 2008-2017 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#include "video/software-driver.hpp"
+
+#include <stdlib.h>
+#include <algorithm>
+#include <pn/file>
+#include <sfz/sfz.hpp>
+
+#include "drawing/shapes.hpp"
+#include "game/sys.hpp"
+#include "math/geometry.hpp"
+#include "ui/card.hpp"
+#include "video/frame-stream.hpp"
+
+using sfz::dec;
+using std::max;
+using std::min;
+using std::pair;
+using std::unique_ptr;
+using std::vector;
+
+namespace path = sfz::path;
+
+namespace antares {
+
+namespace {
+
+const int32_t kStaticSize = 256;
+
+// The product of two channels, as the GPU computes it: 255 is 1.0.
+uint8_t multiply(uint8_t x, uint8_t y) { return ((x * y) + 127) / 255; }
+
+RgbColor multiply(const RgbColor& x, const RgbColor& y) {
+    return rgba(
+            multiply(x.red, y.red), multiply(x.green, y.green), multiply(x.blue, y.blue),
+            multiply(x.alpha, y.alpha));
+}
+
+// Nearest-texel sampling: the texel under the center of pixel `i`, when a span of `source_size`
+// texels is stretched over `dest_size` pixels.
+int32_t sample(int32_t i, int32_t dest_size, int32_t source_size) {
+    return (((2 * i) + 1) * source_size) / (2 * dest_size);
+}
+
+}  // namespace
+
+// Like the OpenGL driver's textures, the image is kept with a clear border one texel wide.
+// Outlines don't sample the border: neighbors past the edge repeat the image's edge texels.
+class SoftwareVideoDriver::TextureImpl : public Texture::Impl {
+  public:
+    TextureImpl(pn::string_view name, SoftwareVideoDriver& driver, const PixMap& content)
+            : _name(name.copy()),
+              _driver(driver),
+              _size(content.size()),
+              _pix(_size.width + 2, _size.height + 2) {
+        _pix.fill(RgbColor::clear());
+        _pix.view(Rect(1, 1, _size.width + 1, _size.height + 1)).copy(content);
+    }
+
+    virtual pn::string_view name() const { return _name; }
+
+    virtual void draw(const Rect& draw_rect) const {
+        each_texel(
+                draw_rect, _size.as_rect(),
+                [](int32_t, int32_t, const RgbColor& texel) -> RgbColor { return texel; });
+    }
+
+    virtual void draw_cropped(const Rect& dest, const Rect& source, const RgbColor& tint) const {
+        draw_shaded(dest, source, tint);
+    }
+
+    virtual void draw_shaded(const Rect& draw_rect, const RgbColor& tint) const {
+        draw_shaded(draw_rect, _size.as_rect(), tint);
+    }
+
+    virtual void draw_static(const Rect& draw_rect, const RgbColor& color, uint8_t frac) const {
+        const SoftwareVideoDriver& driver = _driver;
+        each_texel(
+                draw_rect, _size.as_rect(),
+                [&driver, &color, frac](int32_t x, int32_t y, const RgbColor& texel) -> RgbColor {
+                    if (driver.static_at(x, y, frac)) {
+                        return rgba(
+                                color.red, color.green, color.blue,
+                                multiply(color.alpha, texel.alpha));
+                    }
+                    return texel;
+                });
+    }
+
+    // A texel is part of the outline if it's more opaque than the average of its eight
+    // neighbors.  Like the GL driver's, they're sampled one screen pixel away: `unit_s` and
+    // `unit_t` are texels per pixel.
+    virtual void draw_outlined(
+            const Rect& draw_rect, const RgbColor& outline_color,
+            const RgbColor& fill_color) const {
+        if ((draw_rect.width() <= 0) || (draw_rect.height() <= 0)) {
+            return;
+        }
+        const float unit_s = float(_size.width) / draw_rect.width();
+        const float unit_t = float(_size.height) / draw_rect.height();
+        const float hi_s   = _size.width + 0.5f;
+        const float hi_t   = _size.height + 0.5f;
+        Rect        clipped(draw_rect);
+        clipped.clip_to(_driver._screen_size.as_rect());
+        for (int32_t y = clipped.top; y < clipped.bottom; ++y) {
+            const float t = 1 + ((y - draw_rect.top + 0.5f) * unit_t);
+            for (int32_t x = clipped.left; x < clipped.right; ++x) {
+                const float s = 1 + ((x - draw_rect.left + 0.5f) * unit_s);
+
+                int neighborhood = 0;
+                for (int dt : {-1, 0, 1}) {
+                    for (int ds : {-1, 0, 1}) {
+                        if (ds || dt) {
+                            const float ns = min(max(s + (ds * unit_s), 1.5f), hi_s);
+                            const float nt = min(max(t + (dt * unit_t), 1.5f), hi_t);
+                            neighborhood += _pix.get(int32_t(ns), int32_t(nt)).alpha;
+                        }
+                    }
+                }
+
+                const uint8_t alpha = _pix.get(int32_t(s), int32_t(t)).alpha;
+                if ((alpha * 8) > neighborhood) {
+                    _driver.blend(x, y, outline_color);
+                } else if (alpha > 0) {
+                    _driver.blend(x, y, fill_color);
+                }
+            }
+        }
+    }
+
+    virtual const Size& size() const { return _size; }
+
+  private:
+    void draw_shaded(const Rect& dest, const Rect& source, const RgbColor& tint) const {
+        each_texel(dest, source, [&tint](int32_t, int32_t, const RgbColor& texel) -> RgbColor {
+            return multiply(tint, texel);
+        });
+    }
+
+    // Calls `shade(x, y, texel)` for each on-screen pixel (x, y) of `dest`, with the texel of
+    // `source` that maps to it, and blends the color it returns into the screen.
+    template <typename Shade>
+    void each_texel(const Rect& dest, const Rect& source, Shade shade) const {
+        if ((dest.width() <= 0) || (dest.height() <= 0)) {
+            return;
+        }
+        Rect clipped(dest);
+        clipped.clip_to(_driver._screen_size.as_rect());
+        for (int32_t y = clipped.top; y < clipped.bottom; ++y) {
+            const int32_t   v   = sample(y - dest.top, dest.height(), source.height());
+            const RgbColor* row = _pix.row(source.top + v + 1) + source.left + 1;
+            for (int32_t x = clipped.left; x < clipped.right; ++x) {
+                const int32_t u = sample(x - dest.left, dest.width(), source.width());
+                _driver.blend(x, y, shade(x, y, row[u]));
+            }
+        }
+    }
+
+    const pn::string     _name;
+    SoftwareVideoDriver& _driver;
+    const Size           _size;
+    ArrayPixMap          _pix;
+};
+
+class SoftwareVideoDriver::MainLoop : public EventScheduler::MainLoop {
+  public:
+    MainLoop(
+            SoftwareVideoDriver& driver, const sfz::optional<pn::string>& output_dir,
+            Card* initial)
+            : _driver(driver), _stack(initial) {
+        if (output_dir.has_value()) {
+            _output_dir.emplace(output_dir->copy());
+        }
+    }
+
+    bool takes_snapshots() { return _output_dir.has_value() || _driver._stream; }
+
+    void snapshot(wall_ticks ticks) {
+        if (_driver._stream) {
+            _driver._stream->write(_driver._stream->frame(read(_driver._capture_rect)));
+        } else {
+            snapshot_to(
+                    _driver._capture_rect,
+                    pn::format("screens/{0}.png", dec(ticks.time_since_epoch().count(), 6)));
+        }
+    }
+
+    void snapshot_to(Rect bounds, pn::string_view relpath) {
+        if (!_output_dir.has_value()) {
+            return;
+        }
+        ArrayPixMap pix  = read(bounds);
+        pn::string  path = pn::format("{0}/{1}", *_output_dir, relpath);
+        sfz::makedirs(path::dirname(path), 0755);
+        pn::file file = pn::open(path, "w");
+        pix.encode(file);
+    }
+
+    void draw() {
+        if (done()) {
+            return;
+        }
+        _driver._pix.fill(RgbColor::black());
+        _driver._seed = _driver._static_seed.next(256);
+        _driver._seed <<= 8;
+        _driver._seed += _driver._static_seed.next(256);
+        _stack.top()->draw();
+    }
+    bool  done() const { return _stack.empty(); }
+    Card* top() const { return _stack.top(); }
+
+  private:
+    // Alpha is dropped, as it is when reading back the OpenGL framebuffer.
+    ArrayPixMap read(Rect bounds) const {
+        ArrayPixMap pix(bounds.size());
+        for (int32_t y = 0; y < bounds.height(); ++y) {
+            const RgbColor* row = _driver._pix.row(bounds.top + y) + bounds.left;
+            for (int32_t x = 0; x < bounds.width(); ++x) {
+                pix.set(x, y, rgb(row[x].red, row[x].green, row[x].blue));
+            }
+        }
+        return pix;
+    }
+
+    SoftwareVideoDriver&      _driver;
+    sfz::optional<pn::string> _output_dir;
+    CardStack                 _stack;
+};
+
+SoftwareVideoDriver::SoftwareVideoDriver(
+        Size screen_size, const sfz::optional<pn::string>& output_dir)
+        : _screen_size(screen_size),
+          _capture_rect(screen_size.as_rect()),
+          _pix(screen_size),
+          _static_image(new uint8_t[kStaticSize * kStaticSize]),
+          _static_seed{0} {
+    if (output_dir.has_value()) {
+        _output_dir.emplace(output_dir->copy());
+    }
+    _pix.fill(RgbColor::black());
+    Random static_index = {0};
+    for (int i = 0; i < (kStaticSize * kStaticSize); ++i) {
+        _static_image[i] = static_index.next(256);
+    }
+}
+
+SoftwareVideoDriver::~SoftwareVideoDriver() {}
+
+Texture SoftwareVideoDriver::texture(pn::string_view name, const PixMap& content) {
+    return unique_ptr<Texture::Impl>(new TextureImpl(name, *this, content));
+}
+
+void SoftwareVideoDriver::batch_rect(const Rect& rect, const RgbColor& color) {
+    Rect clipped(rect);
+    clipped.clip_to(_screen_size.as_rect());
+    for (int32_t y = clipped.top; y < clipped.bottom; ++y) {
+        for (int32_t x = clipped.left; x < clipped.right; ++x) {
+            blend(x, y, color);
+        }
+    }
+}
+
+void SoftwareVideoDriver::dither_rect(const Rect& rect, const RgbColor& color) {
+    batch_rect(rect, rgba(color.red, color.green, color.blue, color.alpha / 2));
+}
+
+void SoftwareVideoDriver::batch_point(const Point& at, const RgbColor& color) {
+    if (_screen_size.as_rect().contains(at)) {
+        blend(at.h, at.v, color);
+    }
+}
+
+void SoftwareVideoDriver::draw_point(const Point& at, const RgbColor& color) {
+    batch_point(at, color);
+}
+
+// Covers both end points, like OpenGlVideoDriver::batch_line().
+void SoftwareVideoDriver::batch_line(const Point& from, const Point& to, const RgbColor& color) {
+    const int32_t dx    = abs(to.h - from.h);
+    const int32_t dy    = -abs(to.v - from.v);
+    const int32_t sx    = (from.h < to.h) ? 1 : -1;
+    const int32_t sy    = (from.v < to.v) ? 1 : -1;
+    int32_t       error = dx + dy;
+    Point         p     = from;
+    while (true) {
+        batch_point(p, color);
+        if (p == to) {
+            break;
+        }
+        const int32_t e2 = 2 * error;
+        if (e2 >= dy) {
+            error += dy;
+            p.h += sx;
+        }
+        if (e2 <= dx) {
+            error += dx;
+            p.v += sy;
+        }
+    }
+}
+
+// Like OpenGlVideoDriver::draw_line(), which draws nothing outside of a Lines batch.
+void SoftwareVideoDriver::draw_line(const Point& from, const Point& to, const RgbColor& color) {}
+
+void SoftwareVideoDriver::draw_triangle(const Rect& rect, const RgbColor& color) {
+    draw_shape(_triangles, draw_triangle_up, rect, color);
+}
+
+void SoftwareVideoDriver::draw_diamond(const Rect& rect, const RgbColor& color) {
+    draw_shape(_diamonds, draw_compat_diamond, rect, color);
+}
+
+void SoftwareVideoDriver::draw_plus(const Rect& rect, const RgbColor& color) {
+    draw_shape(_pluses, draw_compat_plus, rect, color);
+}
+
+void SoftwareVideoDriver::draw_shape(
+        std::map<int32_t, Texture>& cache, void (*draw)(PixMap*, const RgbColor&),
+        const Rect& rect, const RgbColor& color) {
+    const int32_t size = min(rect.width(), rect.height());
+    if (size <= 0) {
+        return;
+    }
+    Rect to(0, 0, size, size);
+    to.offset(rect.left, rect.top);
+    if (cache.find(size) == cache.end()) {
+        ArrayPixMap pix(size, size);
+        pix.fill(RgbColor::clear());
+        draw(&pix, RgbColor::white());
+        cache[size] = texture("", pix);
+    }
+    cache[size].draw_shaded(to, color);
+}
+
+// Blends with (SRC_ALPHA, ONE_MINUS_SRC_ALPHA), as the OpenGL driver does.
+void SoftwareVideoDriver::blend(int32_t x, int32_t y, const RgbColor& color) {
+    const int a = color.alpha;
+    if (a == 0) {
+        return;
+    }
+    RgbColor& p = _pix.mutable_row(y)[x];
+    p.red       = ((color.red * a) + (p.red * (255 - a)) + 127) / 255;
+    p.green     = ((color.green * a) + (p.green * (255 - a)) + 127) / 255;
+    p.blue      = ((color.blue * a) + (p.blue * (255 - a)) + 127) / 255;
+    p.alpha     = ((a * a) + (p.alpha * (255 - a)) + 127) / 255;
+}
+
+// The fragment shader samples the static texture at the pixel center, shifted by the frame's
+// seed: a whole row per unit of seed, and a 256th of a column.
+bool SoftwareVideoDriver::static_at(int32_t x, int32_t y, uint8_t frac) const {
+    const int32_t s = (x + ((_seed + 128) >> 8)) & (kStaticSize - 1);
+    const int32_t t = (y + _seed) & (kStaticSize - 1);
+    return _static_image[(t * kStaticSize) + s] <= frac;
+}
+
+void SoftwareVideoDriver::loop(Card* initial, EventScheduler& scheduler) {
+    _scheduler = &scheduler;
+    MainLoop loop(*this, _output_dir, initial);
+    _scheduler->loop(loop);
+    _scheduler = nullptr;
+}
+
+namespace {
+
+class DummyCard : public Card {
+  public:
+    void become_front() {
+        if (!_inited) {
+            sys_init();
+            _inited = true;
+        }
+    }
+
+  private:
+    bool _inited = false;
+};
+
+}  // namespace
+
+void SoftwareVideoDriver::capture(vector<pair<unique_ptr<Card>, pn::string>>& pix) {
+    MainLoop loop(*this, _output_dir, new DummyCard);
+    for (auto& p : pix) {
+        loop.top()->stack()->push(p.first.release());
+        loop.draw();
+        loop.snapshot_to(_capture_rect, p.second);
+        loop.top()->stack()->pop(loop.top());
+    }
+}
+
+}  // namespace antares